@@ -0,0 +1,184 @@
+/**
+ * @file
+ *
+ * @brief Benchmark the query iteration of component registries.
+ *
+ * Compare a registry with dense component IDs and bitset signatures against
+ * per-entity `std::unordered_map<std::type_index, void*>` component maps.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "component-registry.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace b {
+
+struct Position { float x, y, z; };
+struct Velocity { float x, y, z; };
+struct Health   { int hp; };
+struct Armor    { int ac; };
+struct Target   { std::size_t id; };
+struct Sprite   { int frame; };
+
+using Registry = nsfx::component_registry<
+    Position, Velocity, Health, Armor, Target, Sprite>;
+
+constexpr std::size_t num_entities = 1000000;
+constexpr int num_rounds = 10;
+
+/**
+ * @brief The components of all entities.
+ *
+ * Both approaches use the same storage, and differ only in the lookup.
+ */
+struct storage
+{
+    std::vector<Position> positions_;
+    std::vector<Velocity> velocities_;
+    std::vector<Health>   healths_;
+    std::vector<Armor>    armors_;
+
+    explicit storage(std::size_t n)
+        : positions_(n, Position{1, 2, 3}),
+          velocities_(n, Velocity{1, 1, 1}),
+          healths_(n, Health{100}),
+          armors_(n, Armor{10})
+    {
+    }
+};
+
+struct dense_entity
+{
+    Registry::signature_type signature_;
+    void* components_[Registry::size];
+};
+
+struct map_entity
+{
+    std::unordered_map<std::type_index, void*> components_;
+};
+
+template<class F>
+double measure(F&& f)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < num_rounds; ++r)
+    {
+        f();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count()
+         / num_rounds / num_entities;
+}
+
+} // namespace b
+
+
+int main(void)
+{
+    using namespace b;
+    storage s(num_entities);
+    std::srand(1);
+    // The archetype of each entity.
+    std::vector<int> kinds(num_entities);
+    for (auto& k : kinds)
+    {
+        k = std::rand() % 4;
+    }
+    ////////////////////
+    // dense IDs and signatures
+    ////////////////////
+    std::vector<dense_entity> dense(num_entities);
+    for (std::size_t i = 0; i < num_entities; ++i)
+    {
+        auto& e = dense[i];
+        e.components_[Registry::id<Position>()] = &s.positions_[i];
+        e.signature_.set(Registry::id<Position>());
+        if (kinds[i] & 1)
+        {
+            e.components_[Registry::id<Velocity>()] = &s.velocities_[i];
+            e.signature_.set(Registry::id<Velocity>());
+        }
+        if (kinds[i] & 2)
+        {
+            e.components_[Registry::id<Health>()] = &s.healths_[i];
+            e.signature_.set(Registry::id<Health>());
+        }
+    }
+    ////////////////////
+    // std::type_index maps
+    ////////////////////
+    std::vector<map_entity> maps(num_entities);
+    for (std::size_t i = 0; i < num_entities; ++i)
+    {
+        auto& e = maps[i];
+        e.components_[typeid(Position)] = &s.positions_[i];
+        if (kinds[i] & 1)
+        {
+            e.components_[typeid(Velocity)] = &s.velocities_[i];
+        }
+        if (kinds[i] & 2)
+        {
+            e.components_[typeid(Health)] = &s.healths_[i];
+        }
+    }
+    ////////////////////
+    // query: Position + Velocity
+    ////////////////////
+    std::size_t matched_dense = 0;
+    double t_dense = measure([&] {
+        constexpr auto query = Registry::signature<Position, Velocity>();
+        for (auto& e : dense)
+        {
+            if (e.signature_.contains(query))
+            {
+                auto* p = static_cast<Position*>(
+                    e.components_[Registry::id<Position>()]);
+                auto* v = static_cast<Velocity*>(
+                    e.components_[Registry::id<Velocity>()]);
+                p->x += v->x;
+                ++matched_dense;
+            }
+        }
+    });
+    std::size_t matched_map = 0;
+    double t_map = measure([&] {
+        const std::type_index pos = typeid(Position);
+        const std::type_index vel = typeid(Velocity);
+        for (auto& e : maps)
+        {
+            auto ip = e.components_.find(pos);
+            auto iv = e.components_.find(vel);
+            if (ip != e.components_.end() && iv != e.components_.end())
+            {
+                auto* p = static_cast<Position*>(ip->second);
+                auto* v = static_cast<Velocity*>(iv->second);
+                p->x += v->x;
+                ++matched_map;
+            }
+        }
+    });
+    std::cout << "entities:               " << num_entities << std::endl;
+    std::cout << "matched:                " << matched_dense / num_rounds
+              << " / " << matched_map / num_rounds << std::endl;
+    std::cout << "dense id + signature:   " << t_dense << " ns/entity"
+              << std::endl;
+    std::cout << "type_index map:         " << t_map << " ns/entity"
+              << std::endl;
+    std::cout << "speedup:                " << t_map / t_dense << "x"
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file
+ *
+ * @brief Benchmark the throughput of writing small type-tagged records.
+ *
+ * Compare `record_writer` against a `write()` per record, and against
+ * `std::fwrite()` per record.
+ * Pass the path of the output file, which should be on tmpfs, so that the
+ * cost of the writer is measured rather than the cost of the device.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "record-writer.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+namespace b {
+
+struct event
+{
+    std::uint64_t time;
+    std::uint32_t source;
+    std::uint32_t value;
+};
+
+struct sample
+{
+    std::uint64_t time;
+    double value;
+    double error;
+};
+
+constexpr std::uint64_t num_records = 10000000;
+
+// The average size of the records.
+constexpr std::size_t record_size =
+    nsfx::frame_header::size + (sizeof (event) + sizeof (sample)) / 2;
+
+template<class F>
+void measure(const char* what, F f)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(t1 - t0).count();
+    std::cout << what << "\t " << num_records / seconds / 1e6 << "\t\t"
+              << num_records * record_size / seconds / 1e6 << std::endl;
+}
+
+void run_record_writer(const char* path, std::size_t block_size,
+                       std::size_t batch_blocks)
+{
+    nsfx::record_writer w(path, block_size, batch_blocks);
+    for (std::uint64_t i = 0; i < num_records; ++i)
+    {
+        if (i & 1)
+        {
+            w.write(event{i, 1, static_cast<std::uint32_t>(i)});
+        }
+        else
+        {
+            w.write(sample{i, 0.5, 0.1});
+        }
+    }
+    if (!w.flush())
+    {
+        std::cout << "error: " << w.error() << std::endl;
+    }
+}
+
+template<class T>
+std::size_t encode(unsigned char* buf, const T& value)
+{
+    return nsfx::typed_frame<T>::write(buf, value);
+}
+
+void run_fwrite(const char* path)
+{
+    std::FILE* f = std::fopen(path, "wb");
+    unsigned char buf[64];
+    for (std::uint64_t i = 0; i < num_records; ++i)
+    {
+        std::size_t n = (i & 1)
+            ? encode(buf, event{i, 1, static_cast<std::uint32_t>(i)})
+            : encode(buf, sample{i, 0.5, 0.1});
+        std::fwrite(buf, 1, n, f);
+    }
+    std::fclose(f);
+}
+
+void run_write(const char* path)
+{
+    int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    unsigned char buf[64];
+    for (std::uint64_t i = 0; i < num_records; ++i)
+    {
+        std::size_t len = (i & 1)
+            ? encode(buf, event{i, 1, static_cast<std::uint32_t>(i)})
+            : encode(buf, sample{i, 0.5, 0.1});
+        if (::write(fd, buf, len) < 0)
+        {
+            break;
+        }
+    }
+    ::close(fd);
+}
+
+} // namespace b
+
+
+int main(int argc, char* argv[])
+{
+    using namespace b;
+    const char* path = argc > 1 ? argv[1] : "/dev/shm/nsfx-record-writer.bin";
+    std::cout << "writer              M records/s   MB/s" << std::endl;
+    measure("record_writer 1M x8", [&] { run_record_writer(path, 1 << 20, 8); });
+    measure("record_writer 64K x4", [&] { run_record_writer(path, 1 << 16, 4); });
+    measure("fwrite            ", [&] { run_fwrite(path); });
+    measure("write             ", [&] { run_write(path); });
+    std::remove(path);
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file
+ *
+ * @brief Benchmark the scaling of per-type counters from 1 to 64 threads.
+ *
+ * Compare `type_counter<>` against a shared
+ * `std::unordered_map<std::string, std::atomic<std::uint64_t>>`.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "type-counter.hpp"
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace b {
+
+template<int I> struct Msg {};
+
+struct tag {};
+
+constexpr std::uint64_t num_increments = 2000000;
+
+using map_type = std::unordered_map<std::string, std::atomic<std::uint64_t>>;
+
+template<int I>
+void count_map(map_type& m)
+{
+    // `find()` only reads the map, which is filled before the threads start.
+    m.find(std::string{nsfx::type_name_v<Msg<I>>.view()})->second.fetch_add(
+        1, std::memory_order_relaxed);
+}
+
+template<int... Is>
+void fill_map(map_type& m, std::integer_sequence<int, Is...>)
+{
+    (m[std::string{nsfx::type_name_v<Msg<Is>>.view()}], ...);
+}
+
+template<int... Is>
+void run_type_counter(std::integer_sequence<int, Is...>)
+{
+    for (std::uint64_t k = 0; k < num_increments / sizeof...(Is); ++k)
+    {
+        (nsfx::type_counter<Msg<Is>, tag>::increment(), ...);
+    }
+}
+
+template<int... Is>
+void run_map(map_type& m, std::integer_sequence<int, Is...>)
+{
+    for (std::uint64_t k = 0; k < num_increments / sizeof...(Is); ++k)
+    {
+        (count_map<Is>(m), ...);
+    }
+}
+
+template<class F>
+double measure(int num_threads, F f)
+{
+    std::vector<std::thread> threads;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_threads; ++i)
+    {
+        threads.emplace_back(f);
+    }
+    for (auto& th : threads)
+    {
+        th.join();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(t1 - t0).count();
+    // Million increments per second.
+    return num_threads * num_increments / seconds / 1e6;
+}
+
+} // namespace b
+
+
+int main(void)
+{
+    using namespace b;
+    using types = std::make_integer_sequence<int, 8>;
+    map_type m;
+    // The keys are inserted in advance, so the map is only read.
+    fill_map(m, types{});
+    std::cout << "threads  type_counter(M/s)  unordered_map(M/s)" << std::endl;
+    for (int n = 1; n <= 64; n *= 2)
+    {
+        double a = measure(n, [] { run_type_counter(types{}); });
+        double b = measure(n, [&m] { run_map(m, types{}); });
+        std::cout << n << "\t " << a << "\t\t    " << b << std::endl;
+    }
+    std::uint64_t total = 0;
+    for (const auto& c : nsfx::type_counters<tag>::snapshot())
+    {
+        total += c.count_;
+    }
+    std::cout << "total counted: " << total << std::endl;
+
+    return 0;
+}
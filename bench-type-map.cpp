@@ -0,0 +1,113 @@
+/**
+ * @file
+ *
+ * @brief Benchmark the lookups of a service locator.
+ *
+ * Compare `type_map<>` against `std::unordered_map<std::type_index, V>` and
+ * `std::map<std::string, V>` keyed by the type names.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "type-map.hpp"
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+
+namespace b {
+
+template<int I> struct service {};
+
+constexpr int num_services = 32;
+
+constexpr std::uint64_t num_rounds = 1000000;
+
+using types = std::make_integer_sequence<int, num_services>;
+
+template<int... Is>
+void fill(nsfx::type_map<void*>& a,
+          std::unordered_map<std::type_index, void*>& b,
+          std::map<std::string, void*>& c,
+          std::integer_sequence<int, Is...>)
+{
+    static int objects[num_services];
+    (a.insert_or_assign<service<Is>>(&objects[Is]), ...);
+    ((b[typeid(service<Is>)] = &objects[Is]), ...);
+    ((c[std::string{nsfx::type_name_v<service<Is>>.view()}] = &objects[Is]),
+     ...);
+}
+
+template<int... Is>
+std::uintptr_t look_up(const nsfx::type_map<void*>& m,
+                       std::integer_sequence<int, Is...>)
+{
+    return (reinterpret_cast<std::uintptr_t>(m.get<service<Is>>()) ^ ...);
+}
+
+template<int... Is>
+std::uintptr_t look_up(const std::unordered_map<std::type_index, void*>& m,
+                       std::integer_sequence<int, Is...>)
+{
+    return (reinterpret_cast<std::uintptr_t>(
+                m.find(typeid(service<Is>))->second) ^ ...);
+}
+
+template<int... Is>
+std::uintptr_t look_up(const std::map<std::string, void*>& m,
+                       std::integer_sequence<int, Is...>)
+{
+    // The keys are built from the compile-time names, as a string-keyed
+    // locator would.
+    return (reinterpret_cast<std::uintptr_t>(
+                m.find(std::string{nsfx::type_name_v<service<Is>>.view()})
+                 ->second) ^ ...);
+}
+
+template<class M>
+double measure(const M& m)
+{
+    std::uintptr_t sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (std::uint64_t r = 0; r < num_rounds; ++r)
+    {
+        sink += look_up(m, types{});
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    if (sink == 1)
+    {
+        std::cout << "";
+    }
+    // Nanoseconds per lookup.
+    return std::chrono::duration<double, std::nano>(t1 - t0).count()
+         / num_rounds / num_services;
+}
+
+} // namespace b
+
+
+int main(void)
+{
+    using namespace b;
+    nsfx::type_map<void*> a;
+    std::unordered_map<std::type_index, void*> b;
+    std::map<std::string, void*> c;
+    fill(a, b, c, types{});
+    std::cout << "services:                  " << num_services << std::endl;
+    std::cout << "type_map:                  " << measure(a) << " ns/lookup"
+              << std::endl;
+    std::cout << "unordered_map<type_index>: " << measure(b) << " ns/lookup"
+              << std::endl;
+    std::cout << "map<string>:               " << measure(c) << " ns/lookup"
+              << std::endl;
+
+    return 0;
+}
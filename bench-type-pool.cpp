@@ -0,0 +1,120 @@
+/**
+ * @file
+ *
+ * @brief Benchmark the allocation of small objects from 1 to 8 threads.
+ *
+ * Compare `type_pool<>` against `new` and `delete`.
+ * Each thread keeps a window of live objects, and replaces the oldest one
+ * by a new one at each step.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "type-pool.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace b {
+
+struct message
+{
+    std::uint64_t seq;
+    std::uint32_t source;
+    std::uint32_t kind;
+    double value;
+};
+
+constexpr std::uint64_t num_steps = 4000000;
+
+constexpr std::size_t window = 1024;
+
+struct pooled
+{
+    static message* create(std::uint64_t i)
+    {
+        return nsfx::type_pool<message>::create(message{i, 0, 0, 0.0});
+    }
+
+    static void destroy(message* m)
+    {
+        nsfx::type_pool<message>::destroy(m);
+    }
+};
+
+struct global
+{
+    static message* create(std::uint64_t i)
+    {
+        return new message{i, 0, 0, 0.0};
+    }
+
+    static void destroy(message* m)
+    {
+        delete m;
+    }
+};
+
+template<class Alloc>
+void run(void)
+{
+    message* live[window] = {};
+    for (std::uint64_t i = 0; i < num_steps; ++i)
+    {
+        message*& m = live[i % window];
+        Alloc::destroy(m);
+        m = Alloc::create(i);
+    }
+    for (message* m : live)
+    {
+        Alloc::destroy(m);
+    }
+}
+
+template<class F>
+double measure(int num_threads, F f)
+{
+    std::vector<std::thread> threads;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_threads; ++i)
+    {
+        threads.emplace_back(f);
+    }
+    for (auto& th : threads)
+    {
+        th.join();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(t1 - t0).count();
+    // Million allocations per second.
+    return num_threads * num_steps / seconds / 1e6;
+}
+
+} // namespace b
+
+
+int main(void)
+{
+    using namespace b;
+    std::cout << "threads  type_pool(M/s)  new/delete(M/s)" << std::endl;
+    for (int n = 1; n <= 8; n *= 2)
+    {
+        double a = measure(n, run<pooled>);
+        double b = measure(n, run<global>);
+        std::cout << n << "\t " << a << "\t\t " << b << std::endl;
+    }
+    for (const auto& s : nsfx::type_pools::snapshot())
+    {
+        std::cout << s.name_ << ": " << s.allocations_ << " allocations, "
+                  << s.slabs_ << " slabs, " << s.live_ << " live"
+                  << std::endl;
+    }
+
+    return 0;
+}
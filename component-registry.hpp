@@ -0,0 +1,212 @@
+/**
+ * @file
+ *
+ * @brief Component registry with dense component IDs at compile time.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#ifndef COMPONENT_REGISTRY_HPP__7F3A9C1E_5B2D_4E8A_A6C4_1D9E3B7F5A20
+#define COMPONENT_REGISTRY_HPP__7F3A9C1E_5B2D_4E8A_A6C4_1D9E3B7F5A20
+
+#include "type-name.hpp"
+#include "fixed-bitset.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+
+namespace nsfx {
+namespace details {
+namespace component_registry {
+
+template<class... Cs>
+struct table
+{
+    static constexpr std::size_t N = sizeof...(Cs);
+
+    static constexpr std::uint64_t hashes_[] = {
+        nsfx::type_name<Cs>::hash()... };
+    static constexpr std::string_view names_[] = {
+        type_name_v<Cs>.view()... };
+
+    /**
+     * @brief Get the index of `C` within `Cs`.
+     *
+     * @return `N` if `C` is not in `Cs`.
+     */
+    template<class C>
+    static constexpr std::size_t index(void) noexcept
+    {
+        constexpr bool same[] = { std::is_same_v<C, Cs>... };
+        std::size_t i = 0;
+        while (i < N && !same[i])
+        {
+            ++i;
+        }
+        return i;
+    }
+
+    /**
+     * @brief Get the rank of the `i`-th component ordered by `(hash, name)`.
+     */
+    static constexpr std::size_t rank(std::size_t i) noexcept
+    {
+        std::size_t r = 0;
+        for (std::size_t j = 0; j < N; ++j)
+        {
+            if (hashes_[j] < hashes_[i] ||
+                (hashes_[j] == hashes_[i] && names_[j] < names_[i]))
+            {
+                ++r;
+            }
+        }
+        return r;
+    }
+
+    /**
+     * @brief Whether the names of the components are distinct.
+     */
+    static constexpr bool unique(void) noexcept
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            for (std::size_t j = i + 1; j < N; ++j)
+            {
+                if (names_[i] == names_[j])
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static constexpr std::array<std::size_t, N> indices(void) noexcept
+    {
+        std::array<std::size_t, N> result {};
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            result[rank(i)] = i;
+        }
+        return result;
+    }
+};
+
+} // namespace component_registry
+} // namespace details
+
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief A registry of a declared set of component types.
+ *
+ * Each component is assigned a dense ID within `[0, size)`.
+ * The IDs are the ranks of the components ordered by the hashes of their
+ * names (and then by the names).
+ * Therefore, the IDs are deterministic, and do not depend upon the order
+ * in which the components are declared.
+ *
+ * The signature of an archetype is a bitset whose `i`-th bit indicates
+ * whether the component with ID `i` is present.
+ *
+ * @tparam Cs The component types.
+ *            Their names **must** be distinct.
+ */
+template<class... Cs>
+struct component_registry
+{
+    static_assert(sizeof...(Cs) > 0, "The registry must not be empty.");
+
+private:
+    using table_ = details::component_registry::table<Cs...>;
+
+    static_assert(table_::unique(),
+                  "The names of the components must be distinct.");
+
+    static constexpr std::array<std::size_t, sizeof...(Cs)> indices_ =
+        table_::indices();
+
+public:
+    static constexpr std::size_t size = sizeof...(Cs);
+
+    using signature_type = fixed_bitset<size>;
+
+    /**
+     * @brief Whether a type is a registered component.
+     */
+    template<class C>
+    static constexpr bool contains(void) noexcept
+    {
+        return table_::template index<C>() < size;
+    }
+
+    /**
+     * @brief Get the ID of a component.
+     */
+    template<class C>
+    static constexpr std::size_t id(void) noexcept
+    {
+        constexpr std::size_t i = table_::template index<C>();
+        static_assert(i < size, "The type is not a registered component.");
+        return table_::rank(i);
+    }
+
+    /**
+     * @brief Get the signature of an archetype.
+     */
+    template<class... Qs>
+    static constexpr signature_type signature(void) noexcept
+    {
+        signature_type result;
+        (result.set(id<Qs>()), ...);
+        return result;
+    }
+
+    /**
+     * @brief Get the name of a component by its ID.
+     *
+     * @pre `id < size`.
+     */
+    static constexpr std::string_view name(std::size_t id) noexcept
+    {
+        return table_::names_[indices_[id]];
+    }
+
+    /**
+     * @brief Get the name hash of a component by its ID.
+     *
+     * @pre `id < size`.
+     */
+    static constexpr std::uint64_t hash(std::size_t id) noexcept
+    {
+        return table_::hashes_[indices_[id]];
+    }
+};
+
+/**
+ * @brief The ID of a component within a registry.
+ */
+template<class Registry, class C>
+inline constexpr std::size_t component_id_v = Registry::template id<C>();
+
+/**
+ * @brief The signature of an archetype within a registry.
+ */
+template<class Registry, class... Qs>
+inline constexpr typename Registry::signature_type component_signature_v =
+    Registry::template signature<Qs...>();
+
+} // namespace nsfx
+
+
+#endif // COMPONENT_REGISTRY_HPP__7F3A9C1E_5B2D_4E8A_A6C4_1D9E3B7F5A20
@@ -0,0 +1,198 @@
+/**
+ * @file
+ *
+ * @brief Fixed size bitset at compile time.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#ifndef FIXED_BITSET_HPP__E2A4C6D8_1B3F_4A5C_8E7D_9F0B2C4E6A81
+#define FIXED_BITSET_HPP__E2A4C6D8_1B3F_4A5C_8E7D_9F0B2C4E6A81
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace nsfx {
+
+/**
+ * @brief A fixed size bitset.
+ *
+ * Unlike `std::bitset<>` in C++17, all operations are `constexpr`,
+ * and the words are accessible.
+ *
+ * @tparam N The number of bits.
+ */
+template<std::size_t N>
+struct fixed_bitset
+{
+    using word_type = std::uint64_t;
+
+    static constexpr std::size_t bits_per_word = 64;
+    static constexpr std::size_t num_words =
+        N ? (N + bits_per_word - 1) / bits_per_word : 1;
+
+    word_type words_[num_words];
+
+    constexpr fixed_bitset(void) noexcept
+        : words_{}
+    {
+    }
+
+    static constexpr std::size_t size(void) noexcept
+    {
+        return N;
+    }
+
+    constexpr fixed_bitset& set(std::size_t i) noexcept
+    {
+        words_[i / bits_per_word] |= word_type{1} << (i % bits_per_word);
+        return *this;
+    }
+
+    constexpr fixed_bitset& reset(std::size_t i) noexcept
+    {
+        words_[i / bits_per_word] &= ~(word_type{1} << (i % bits_per_word));
+        return *this;
+    }
+
+    constexpr bool test(std::size_t i) const noexcept
+    {
+        return (words_[i / bits_per_word] >> (i % bits_per_word)) & 1;
+    }
+
+    constexpr bool operator[](std::size_t i) const noexcept
+    {
+        return test(i);
+    }
+
+    constexpr std::size_t count(void) const noexcept
+    {
+        std::size_t n = 0;
+        for (word_type w : words_)
+        {
+            while (w)
+            {
+                w &= w - 1;
+                ++n;
+            }
+        }
+        return n;
+    }
+
+    constexpr bool none(void) const noexcept
+    {
+        for (word_type w : words_)
+        {
+            if (w)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Whether all bits in `other` are also set in this bitset.
+     */
+    constexpr bool contains(const fixed_bitset& other) const noexcept
+    {
+        for (std::size_t i = 0; i < num_words; ++i)
+        {
+            if ((words_[i] & other.words_[i]) != other.words_[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Whether any bit in `other` is also set in this bitset.
+     */
+    constexpr bool intersects(const fixed_bitset& other) const noexcept
+    {
+        for (std::size_t i = 0; i < num_words; ++i)
+        {
+            if (words_[i] & other.words_[i])
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    constexpr fixed_bitset& operator|=(const fixed_bitset& other) noexcept
+    {
+        for (std::size_t i = 0; i < num_words; ++i)
+        {
+            words_[i] |= other.words_[i];
+        }
+        return *this;
+    }
+
+    constexpr fixed_bitset& operator&=(const fixed_bitset& other) noexcept
+    {
+        for (std::size_t i = 0; i < num_words; ++i)
+        {
+            words_[i] &= other.words_[i];
+        }
+        return *this;
+    }
+
+    friend constexpr fixed_bitset
+    operator|(fixed_bitset lhs, const fixed_bitset& rhs) noexcept
+    {
+        return lhs |= rhs;
+    }
+
+    friend constexpr fixed_bitset
+    operator&(fixed_bitset lhs, const fixed_bitset& rhs) noexcept
+    {
+        return lhs &= rhs;
+    }
+
+    friend constexpr bool
+    operator==(const fixed_bitset& lhs, const fixed_bitset& rhs) noexcept
+    {
+        for (std::size_t i = 0; i < num_words; ++i)
+        {
+            if (lhs.words_[i] != rhs.words_[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend constexpr bool
+    operator!=(const fixed_bitset& lhs, const fixed_bitset& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * @brief Convert to a `std::bitset<>`.
+     */
+    std::bitset<N> to_bitset(void) const noexcept
+    {
+        std::bitset<N> result;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            result[i] = test(i);
+        }
+        return result;
+    }
+};
+
+} // namespace nsfx
+
+
+#endif // FIXED_BITSET_HPP__E2A4C6D8_1B3F_4A5C_8E7D_9F0B2C4E6A81
@@ -0,0 +1,200 @@
+/**
+ * @file
+ *
+ * @brief OpenMetrics text exporter of per-type counters and histograms.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#ifndef OPENMETRICS_HPP__8E2C4A6F_0B9D_4C31_95E7_D4A1F6B3C859
+#define OPENMETRICS_HPP__8E2C4A6F_0B9D_4C31_95E7_D4A1F6B3C859
+
+#include "type-counter.hpp"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace nsfx {
+
+/**
+ * @brief Write per-type metrics in the OpenMetrics text format.
+ *
+ * The type names are labelled by their escaped forms that are computed at
+ * compile time, and registered along with the counters and the histograms
+ * (see `type_counters<>::load()`), so a scrape only copies them.
+ * The text is written into a buffer that is reused by subsequent scrapes,
+ * thus no allocation happens once the buffers have grown to their steady
+ * sizes.
+ *
+ * @code
+ * nsfx::openmetrics_exporter e;
+ * // For each scrape.
+ * e.clear();
+ * e.counters<Tag>("messages", "Messages by type.");
+ * e.histograms<Tag>("latency_ns", "Latency by type.");
+ * send(e.finish());
+ * @endcode
+ */
+class openmetrics_exporter
+{
+public:
+    /**
+     * @brief Clear the text, and keep the buffers.
+     */
+    void clear(void) noexcept
+    {
+        buffer_.clear();
+    }
+
+    /**
+     * @brief Write the counters of a domain as a counter family.
+     *
+     * @param[in] name  The name of the metric family.
+     * @param[in] help  The help text.
+     * @param[in] label The name of the label that holds the type name.
+     */
+    template<class Tag>
+    void counters(std::string_view name, std::string_view help,
+                  std::string_view label = "type")
+    {
+        type_counters<Tag>::load(entries_, labels_, counts_);
+        header(name, "counter", help);
+        for (std::size_t id = 0; id < entries_.size(); ++id)
+        {
+            sample(name, "_total", label, labels_[id], {}, counts_[id]);
+        }
+    }
+
+    /**
+     * @brief Write the histograms of a domain as a histogram family.
+     *
+     * @param[in] name  The name of the metric family.
+     * @param[in] help  The help text.
+     * @param[in] label The name of the label that holds the type name.
+     */
+    template<class Tag>
+    void histograms(std::string_view name, std::string_view help,
+                    std::string_view label = "type")
+    {
+        using aggregator = type_histograms<Tag>;
+        constexpr std::size_t B = aggregator::num_buckets;
+        constexpr std::size_t W = B + 1;
+        type_histograms<Tag>::load(entries_, labels_, counts_);
+        header(name, "histogram", help);
+        for (std::size_t id = 0; id < entries_.size(); ++id)
+        {
+            const std::string_view value = labels_[id];
+            const std::uint64_t* c = counts_.data() + id * W;
+            std::uint64_t cumulative = 0;
+            for (std::size_t b = 0; b < B; ++b)
+            {
+                cumulative += c[b];
+                sample(name, "_bucket", label, value,
+                       b < B - 1 ? le(aggregator::traits_type::bounds[b])
+                                 : std::string_view{"+Inf"},
+                       cumulative);
+            }
+            sample(name, "_count", label, value, {}, cumulative);
+            sample(name, "_sum", label, value, {}, c[B]);
+        }
+    }
+
+    /**
+     * @brief Terminate the text.
+     *
+     * @return The text, which is valid until the next modification.
+     */
+    std::string_view finish(void)
+    {
+        buffer_.append("# EOF\n");
+        return buffer_;
+    }
+
+    /**
+     * @brief Get the text.
+     */
+    std::string_view view(void) const noexcept
+    {
+        return buffer_;
+    }
+
+private:
+    void header(std::string_view name, std::string_view type,
+                std::string_view help)
+    {
+        buffer_.append("# TYPE ").append(name).append(" ")
+               .append(type).append("\n");
+        buffer_.append("# HELP ").append(name).append(" ");
+        for (const char c : help)
+        {
+            switch (c)
+            {
+            case '\\': buffer_.append("\\\\"); break;
+            case '\n': buffer_.append("\\n");  break;
+            default:   buffer_.push_back(c);   break;
+            }
+        }
+        buffer_.append("\n");
+    }
+
+    /**
+     * @brief Write a sample.
+     *
+     * @param[in] value The escaped value of the label.
+     * @param[in] le    The value of the `le` label, or empty.
+     */
+    void sample(std::string_view name, std::string_view suffix,
+                std::string_view label, std::string_view value,
+                std::string_view le, std::uint64_t number)
+    {
+        buffer_.append(name).append(suffix).append("{")
+               .append(label).append("=\"").append(value).append("\"");
+        if (!le.empty())
+        {
+            buffer_.append(",le=\"").append(le).append("\"");
+        }
+        buffer_.append("} ");
+        append(number);
+        buffer_.append("\n");
+    }
+
+    void append(std::uint64_t number)
+    {
+        char buf[24];
+        auto r = std::to_chars(buf, buf + sizeof (buf), number);
+        buffer_.append(buf, r.ptr);
+    }
+
+    /**
+     * @brief Format the bound of a bucket.
+     *
+     * @return The returned string is valid until the next call.
+     */
+    std::string_view le(std::uint64_t bound) noexcept
+    {
+        auto r = std::to_chars(le_, le_ + sizeof (le_), bound);
+        return std::string_view{le_, static_cast<std::size_t>(r.ptr - le_)};
+    }
+
+    std::string buffer_;
+    std::vector<type_info_entry> entries_;
+    std::vector<std::string_view> labels_;
+    std::vector<std::uint64_t> counts_;
+    char le_[24];
+};
+
+} // namespace nsfx
+
+
+#endif // OPENMETRICS_HPP__8E2C4A6F_0B9D_4C31_95E7_D4A1F6B3C859
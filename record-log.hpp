@@ -0,0 +1,406 @@
+/**
+ * @file
+ *
+ * @brief Memory-mapped reader of type-tagged record logs.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#ifndef RECORD_LOG_HPP__7B15E8D2_C04A_4F63_9E2B_A6D30F47C851
+#define RECORD_LOG_HPP__7B15E8D2_C04A_4F63_9E2B_A6D30F47C851
+
+#include "typed-frame.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace nsfx {
+
+/**
+ * @brief Read a log of type-tagged records (see `record_writer`) by mapping
+ *        it into memory.
+ *
+ * `index()` builds the offsets of the records of each type hash in a single
+ * pass.
+ * Then, `for_each<T>()` visits only the records of a type.
+ * The payloads are **not** copied.
+ *
+ * The padding frames are skipped.
+ * So are the zeros that fill the rest of a block of `alignment` bytes if it
+ * is shorter than a frame header, which are left by earlier writers.
+ *
+ * An incomplete record at the end of the log, e.g., left by a crash, is
+ * ignored, and `index()` reports it.
+ *
+ * @code
+ * nsfx::record_log log("events.log");
+ * if (!log.index(8, 1 << 20)) { ... }   // log.valid_size() < log.size()
+ * log.for_each<event>([] (const nsfx::frame_view& f) {
+ *     event e;
+ *     f.load(e);
+ * });
+ * @endcode
+ */
+class record_log
+{
+public:
+    using offsets_type = std::vector<std::uint64_t>;
+
+    /**
+     * @brief The alignment of the blocks of `record_writer`.
+     */
+    static constexpr std::size_t alignment = 4096;
+
+    /**
+     * @brief Map a file.
+     *
+     * Check `error()` for the failure to open or map the file.
+     */
+    explicit record_log(const char* path)
+        : data_(nullptr),
+          size_(0),
+          valid_size_(0),
+          indexed_(false),
+          error_(0)
+    {
+        const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            error_ = errno;
+            return;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) < 0)
+        {
+            error_ = errno;
+        }
+        else if (st.st_size > 0)
+        {
+            void* p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size),
+                             PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED)
+            {
+                error_ = errno;
+            }
+            else
+            {
+                data_ = static_cast<const unsigned char*>(p);
+                size_ = static_cast<std::size_t>(st.st_size);
+                ::madvise(p, size_, MADV_SEQUENTIAL);
+            }
+        }
+        // The mapping outlives the file descriptor.
+        ::close(fd);
+    }
+
+    record_log(const record_log&) = delete;
+    record_log& operator=(const record_log&) = delete;
+
+    ~record_log(void)
+    {
+        if (data_)
+        {
+            ::munmap(const_cast<unsigned char*>(data_), size_);
+        }
+    }
+
+    /**
+     * @brief Get the `errno` of the failure to open or map the file, or `0`.
+     */
+    int error(void) const noexcept
+    {
+        return error_;
+    }
+
+    const unsigned char* data(void) const noexcept
+    {
+        return data_;
+    }
+
+    /**
+     * @brief Get the size of the file.
+     */
+    std::size_t size(void) const noexcept
+    {
+        return size_;
+    }
+
+    /**
+     * @brief Get the size of the records that can be read.
+     *
+     * @pre `indexed()`.
+     */
+    std::size_t valid_size(void) const noexcept
+    {
+        return valid_size_;
+    }
+
+    /**
+     * @brief Build the offsets of the records of each type hash.
+     *
+     * If the block size is given, the log is split at the block boundaries
+     * into chunks that are indexed by the threads.
+     * It is valid since `record_writer` never writes a record across a block
+     * boundary.
+     * If a record crosses a boundary nevertheless, e.g., the log is not
+     * written by `record_writer` or the block size is wrong, the log is
+     * indexed again without blocks by a single thread.
+     *
+     * The records are indexed up to the first one that cannot be read, i.e.,
+     * `valid_size()`.
+     *
+     * @param[in] num_threads The number of threads.
+     * @param[in] block_size  The block size of the writer, or `0` to index
+     *                        without blocks by a single thread.
+     *
+     * @return `false` if the log cannot be read to its end, e.g., it ends
+     *         with an incomplete record, or it is corrupted.
+     */
+    bool index(std::size_t num_threads = 1, std::size_t block_size = 0)
+    {
+        index_.clear();
+        const std::size_t num_blocks =
+            block_size ? (size_ + block_size - 1) / block_size : 0;
+        if (num_threads > num_blocks)
+        {
+            num_threads = num_blocks;
+        }
+        bool valid = false;
+        if (num_threads)
+        {
+            // The chunks and their indexes.
+            std::vector<std::pair<std::size_t, std::size_t>> chunks;
+            for (std::size_t i = 0; i < num_threads; ++i)
+            {
+                const std::size_t b = num_blocks * i / num_threads;
+                const std::size_t e = num_blocks * (i + 1) / num_threads;
+                chunks.emplace_back(b * block_size,
+                                    std::min(e * block_size, size_));
+            }
+            std::vector<index_type> indexes(num_threads);
+            std::vector<std::size_t> ends(num_threads);
+            if (num_threads == 1)
+            {
+                ends[0] = scan(0, size_, indexes[0]);
+            }
+            else
+            {
+                std::vector<std::thread> threads;
+                for (std::size_t i = 0; i < num_threads; ++i)
+                {
+                    threads.emplace_back([&, i] {
+                        ends[i] = scan(chunks[i].first, chunks[i].second,
+                                       indexes[i]);
+                    });
+                }
+                for (auto& th : threads)
+                {
+                    th.join();
+                }
+            }
+            // Only the last block may end with an incomplete record.
+            valid = ends.back() >= (num_blocks - 1) * block_size;
+            for (std::size_t i = 0; i + 1 < num_threads; ++i)
+            {
+                valid = valid && ends[i] == chunks[i].second;
+            }
+            if (valid)
+            {
+                merge(indexes);
+                valid_size_ = ends.back();
+            }
+        }
+        if (!valid)
+        {
+            index_.clear();
+            valid_size_ = scan(0, size_, index_);
+        }
+        indexed_ = true;
+        return valid_size_ == size_;
+    }
+
+    /**
+     * @brief Check whether the log has been indexed.
+     */
+    bool indexed(void) const noexcept
+    {
+        return indexed_;
+    }
+
+    /**
+     * @brief Get the offsets of the records of a type hash.
+     *
+     * @pre `indexed()`.
+     */
+    const offsets_type& offsets(std::uint64_t type_hash) const
+    {
+        static const offsets_type empty;
+        auto it = index_.find(type_hash);
+        return it == index_.end() ? empty : it->second;
+    }
+
+    template<class T>
+    const offsets_type& offsets(void) const
+    {
+        return offsets(typed_frame<T>::type_hash);
+    }
+
+    /**
+     * @brief Get the number of distinct type hashes.
+     *
+     * @pre `indexed()`.
+     */
+    std::size_t num_types(void) const noexcept
+    {
+        return index_.size();
+    }
+
+    /**
+     * @brief Get the record at an offset.
+     *
+     * @pre `offset` is the offset of a complete record.
+     */
+    frame_view at(std::uint64_t offset) const noexcept
+    {
+        const unsigned char* p = data_ + offset;
+        const frame_header h = read_frame_header(p);
+        return frame_view{h.type_hash_, p + frame_header::size,
+                          static_cast<std::size_t>(h.payload_len_)};
+    }
+
+    /**
+     * @brief Visit the records of a type in order.
+     *
+     * The log is scanned without blocks if it has not been indexed.
+     * The scan stops at the same record as `index()`, which tells whether
+     * the log has been read to its end.
+     *
+     * @param[in] visitor Called with `const frame_view&`.
+     *
+     * @return The number of records visited.
+     */
+    template<class T, class Visitor>
+    std::size_t for_each(Visitor&& visitor) const
+    {
+        constexpr std::uint64_t type_hash = typed_frame<T>::type_hash;
+        if (indexed_)
+        {
+            const offsets_type& o = offsets(type_hash);
+            for (const std::uint64_t offset : o)
+            {
+                visitor(at(offset));
+            }
+            return o.size();
+        }
+        std::size_t count = 0;
+        walk(0, size_, [&] (std::size_t, const frame_view& f) {
+            if (f.type_hash_ == type_hash)
+            {
+                visitor(f);
+                ++count;
+            }
+        });
+        return count;
+    }
+
+private:
+    using index_type = std::unordered_map<std::uint64_t, offsets_type>;
+
+    /**
+     * @brief Visit the records within `[begin, end)`, except the padding.
+     *
+     * A gap of zeros that is shorter than a frame header, and ends at
+     * a multiple of `alignment`, is skipped if no frame can be read at it.
+     *
+     * @param[in] visitor Called with the offset and the frame.
+     *
+     * @return The end of the records that can be read.
+     */
+    template<class Visitor>
+    std::size_t walk(std::size_t begin, std::size_t end,
+                     Visitor&& visitor) const
+    {
+        std::size_t offset = begin;
+        while (offset < end)
+        {
+            frame_reader r(data_ + offset, end - offset);
+            frame_view f;
+            if (r.next(f))
+            {
+                if (f.type_hash_ != padding_frame_hash)
+                {
+                    visitor(offset, static_cast<const frame_view&>(f));
+                }
+                offset += r.consumed();
+                continue;
+            }
+            const std::size_t gap = alignment - offset % alignment;
+            if (gap >= frame_header::size || offset + gap > end ||
+                std::any_of(data_ + offset, data_ + offset + gap,
+                            [] (unsigned char c) { return c != 0; }))
+            {
+                break;
+            }
+            offset += gap;
+        }
+        return offset;
+    }
+
+    /**
+     * @brief Index the records within `[begin, end)`.
+     *
+     * @return The end of the records that can be read.
+     */
+    std::size_t scan(std::size_t begin, std::size_t end, index_type& index) const
+    {
+        return walk(begin, end, [&] (std::size_t offset, const frame_view& f) {
+            index[f.type_hash_].push_back(offset);
+        });
+    }
+
+    /**
+     * @brief Concatenate the indexes of the chunks in order.
+     */
+    void merge(std::vector<index_type>& indexes)
+    {
+        index_ = std::move(indexes[0]);
+        for (std::size_t i = 1; i < indexes.size(); ++i)
+        {
+            for (auto& [type_hash, o] : indexes[i])
+            {
+                offsets_type& dst = index_[type_hash];
+                dst.insert(dst.end(), o.begin(), o.end());
+            }
+        }
+    }
+
+    const unsigned char* data_;
+    std::size_t size_;
+    std::size_t valid_size_;
+    bool indexed_;
+    int error_;
+    index_type index_;
+};
+
+} // namespace nsfx
+
+
+#endif // RECORD_LOG_HPP__7B15E8D2_C04A_4F63_9E2B_A6D30F47C851
@@ -0,0 +1,369 @@
+/**
+ * @file
+ *
+ * @brief Batched writer of type-tagged records.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#ifndef RECORD_WRITER_HPP__E3C71A05_84D2_4B9F_A61E_5F0B2D8C93A7
+#define RECORD_WRITER_HPP__E3C71A05_84D2_4B9F_A61E_5F0B2D8C93A7
+
+#include "typed-frame.hpp"
+
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+
+namespace nsfx {
+
+/**
+ * @brief Write type-tagged records (see `typed_frame<T>`) to a file in
+ *        batches.
+ *
+ * The records are appended to aligned blocks of `block_size` bytes.
+ * A record never crosses a block boundary: the rest of a block that cannot
+ * hold the next record is filled by a padding frame.
+ * A record either fills the rest of a block, or leaves room for a padding
+ * frame, so the frames of a block always end at the block boundary.
+ * Thus, a reader can split the file at block boundaries (see `record_log`).
+ *
+ * A batch of `batch_blocks` full blocks is flushed by a single `writev()`,
+ * or by several if it has more than `IOV_MAX` blocks.
+ *
+ * It is not thread-safe.
+ *
+ * @code
+ * nsfx::record_writer w("events.log");
+ * w.write(ping{1});
+ * w.write<chat>(text.data(), text.size());
+ * w.flush();
+ * @endcode
+ */
+class record_writer
+{
+public:
+    /**
+     * @brief The alignment of the blocks.
+     */
+    static constexpr std::size_t alignment = 4096;
+
+    /**
+     * @brief Write to a file descriptor.
+     *
+     * The file descriptor is not closed by the writer.
+     *
+     * @param[in] block_size   A multiple of `alignment`.
+     * @param[in] batch_blocks The number of blocks in a batch.
+     */
+    explicit record_writer(int fd, std::size_t block_size = 1 << 20,
+                           std::size_t batch_blocks = 8)
+        : fd_(fd),
+          owns_fd_(false)
+    {
+        init(block_size, batch_blocks);
+    }
+
+    /**
+     * @brief Create a file, or truncate an existing file, and write to it.
+     *
+     * Check `error()` for the failure to open the file.
+     */
+    explicit record_writer(const char* path, std::size_t block_size = 1 << 20,
+                           std::size_t batch_blocks = 8)
+        : fd_(::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)),
+          owns_fd_(true)
+    {
+        if (fd_ < 0)
+        {
+            error_ = errno;
+        }
+        init(block_size, batch_blocks);
+    }
+
+    record_writer(const record_writer&) = delete;
+    record_writer& operator=(const record_writer&) = delete;
+
+    /**
+     * @brief Flush the records, and close the file if it is owned.
+     */
+    ~record_writer(void)
+    {
+        flush();
+        if (owns_fd_ && fd_ >= 0)
+        {
+            ::close(fd_);
+        }
+        for (unsigned char* b : blocks_)
+        {
+            ::operator delete(b, std::align_val_t{alignment});
+        }
+    }
+
+    /**
+     * @brief Write a record whose payload is the object representation of a
+     *        value.
+     *
+     * @return `false` if the record does not fit in a block (see
+     *         `fits()`), or the writer has failed.
+     */
+    template<class T>
+    bool write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "The payload must be trivially copyable.");
+        return append(typed_frame<T>::type_hash, &value, sizeof (T));
+    }
+
+    /**
+     * @brief Write a record of a type.
+     *
+     * @return `false` if the record does not fit in a block (see
+     *         `fits()`), or the writer has failed.
+     */
+    template<class T>
+    bool write(const void* payload, std::size_t len)
+    {
+        return append(typed_frame<T>::type_hash, payload, len);
+    }
+
+    /**
+     * @brief Check whether a record fits in a block.
+     *
+     * The header and the payload must fill a block exactly, or leave room
+     * for a padding frame.
+     */
+    bool fits(std::size_t len) const noexcept
+    {
+        return len == block_size_ - frame_header::size ||
+               len <= block_size_ - 2 * frame_header::size;
+    }
+
+    /**
+     * @brief Write all records.
+     *
+     * The current block is not padded, and subsequent records are appended
+     * to it.
+     *
+     * @return `false` if the writer has failed.
+     */
+    bool flush(void)
+    {
+        if (!error_)
+        {
+            submit(true);
+        }
+        return !error_;
+    }
+
+    /**
+     * @brief Get the `errno` of the first failure, or `0`.
+     */
+    int error(void) const noexcept
+    {
+        return error_;
+    }
+
+    std::size_t block_size(void) const noexcept
+    {
+        return block_size_;
+    }
+
+    /**
+     * @brief Get the number of bytes that have been submitted.
+     */
+    std::uint64_t offset(void) const noexcept
+    {
+        return offset_;
+    }
+
+private:
+    void init(std::size_t block_size, std::size_t batch_blocks)
+    {
+        block_size_ = (block_size + alignment - 1) / alignment * alignment;
+        batch_blocks_ = batch_blocks ? batch_blocks : 1;
+        blocks_.resize(batch_blocks_);
+        for (unsigned char*& b : blocks_)
+        {
+            b = static_cast<unsigned char*>(
+                ::operator new(block_size_, std::align_val_t{alignment}));
+        }
+        iovecs_.resize(blocks_.size() + 1);
+        if (owns_fd_ || fd_ < 0)
+        {
+            offset_ = 0;
+        }
+        else
+        {
+            const off_t pos = ::lseek(fd_, 0, SEEK_CUR);
+            offset_ = pos < 0 ? 0 : static_cast<std::uint64_t>(pos);
+        }
+    }
+
+    bool append(std::uint64_t type_hash, const void* payload, std::size_t len)
+    {
+        if (error_ || !fits(len))
+        {
+            return false;
+        }
+        const std::size_t size = frame_header::size + len;
+        // The rest of a block should be empty, or hold a padding frame.
+        // A record that fits is appended to an empty block anyway.
+        const std::size_t rest = block_size_ - used_;
+        if (used_ && size != rest && size + frame_header::size > rest)
+        {
+            next_block();
+            if (error_)
+            {
+                return false;
+            }
+        }
+        unsigned char* p = blocks_[cur_] + used_;
+        write_frame_header(p, frame_header{type_hash, len});
+        if (len)
+        {
+            std::memcpy(p + frame_header::size, payload, len);
+        }
+        used_ += size;
+        if (used_ == block_size_)
+        {
+            next_block();
+        }
+        return !error_;
+    }
+
+    /**
+     * @brief Pad the current block, and move to the next block.
+     *
+     * The rest of the block is empty, or can hold a padding frame.
+     */
+    void next_block(void)
+    {
+        const std::size_t rest = block_size_ - used_;
+        if (rest)
+        {
+            unsigned char* p = blocks_[cur_] + used_;
+            write_frame_header(
+                p, frame_header{padding_frame_hash, rest - frame_header::size});
+            // Leak no stale bytes of the reused block.
+            std::memset(p + frame_header::size, 0, rest - frame_header::size);
+        }
+        ++full_;
+        cur_ = (cur_ + 1) % blocks_.size();
+        used_ = 0;
+        if (full_ == batch_blocks_)
+        {
+            submit(false);
+        }
+    }
+
+    /**
+     * @brief Submit the full blocks, and optionally the current block.
+     */
+    void submit(bool partial)
+    {
+        std::size_t n = 0;
+        std::size_t bytes = 0;
+        std::size_t first = (cur_ + blocks_.size() - full_) % blocks_.size();
+        for (std::size_t i = 0; i < full_; ++i)
+        {
+            const std::size_t skip = i ? 0 : head_flushed_;
+            unsigned char* b = blocks_[(first + i) % blocks_.size()];
+            iovecs_[n++] = iovec{b + skip, block_size_ - skip};
+            bytes += block_size_ - skip;
+        }
+        const std::size_t skip = full_ ? 0 : head_flushed_;
+        if (partial && used_ > skip)
+        {
+            iovecs_[n++] = iovec{blocks_[cur_] + skip, used_ - skip};
+            bytes += used_ - skip;
+        }
+        full_ = 0;
+        // The part of the current block that has been submitted.
+        head_flushed_ = partial ? used_ : 0;
+        if (!n)
+        {
+            return;
+        }
+        write_all(n);
+        offset_ += bytes;
+    }
+
+    /**
+     * @brief Write the vectors, and retry on partial writes.
+     *
+     * At most `IOV_MAX` vectors are written by a `writev()`.
+     */
+    void write_all(std::size_t n)
+    {
+        iovec* v = iovecs_.data();
+        while (n)
+        {
+            const std::size_t count =
+                n < std::size_t{IOV_MAX} ? n : std::size_t{IOV_MAX};
+            const ssize_t r = ::writev(fd_, v, static_cast<int>(count));
+            if (r < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                error_ = errno;
+                return;
+            }
+            auto left = static_cast<std::size_t>(r);
+            while (n && left >= v->iov_len)
+            {
+                left -= v->iov_len;
+                ++v;
+                --n;
+            }
+            if (n)
+            {
+                v->iov_base = static_cast<unsigned char*>(v->iov_base) + left;
+                v->iov_len -= left;
+            }
+        }
+    }
+
+    int fd_;
+    bool owns_fd_;
+    int error_ = 0;
+    std::size_t block_size_ = 0;
+    std::size_t batch_blocks_ = 0;
+    // A ring of blocks.
+    std::vector<unsigned char*> blocks_;
+    std::vector<iovec> iovecs_;
+    // The index of the current block.
+    std::size_t cur_ = 0;
+    // The number of bytes used in the current block.
+    std::size_t used_ = 0;
+    // The number of full blocks that precede the current block.
+    std::size_t full_ = 0;
+    // The number of bytes of the first unsubmitted block that have been
+    // submitted by `flush()`.
+    std::size_t head_flushed_ = 0;
+    // The file offset of the next submission.
+    std::uint64_t offset_ = 0;
+};
+
+} // namespace nsfx
+
+
+#endif // RECORD_WRITER_HPP__E3C71A05_84D2_4B9F_A61E_5F0B2D8C93A7
@@ -0,0 +1,93 @@
+/**
+ * @file
+ *
+ * @brief Component registry with dense component IDs at compile time.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "component-registry.hpp"
+
+namespace t {
+
+struct Position {};
+struct Velocity {};
+struct Health {};
+struct Name {};
+
+struct Renamed {};
+
+} // namespace t
+
+template<>
+struct nsfx::type_name_override<t::Renamed>
+{
+    static constexpr std::string_view name = "game.Tag";
+};
+
+namespace t {
+
+using R1 = nsfx::component_registry<Position, Velocity, Health, Name>;
+using R2 = nsfx::component_registry<Name, Health, Velocity, Position>;
+
+template<class R>
+void show(void)
+{
+    for (std::size_t i = 0; i < R::size; ++i)
+    {
+        std::cout << i << ": " << R::name(i)
+                  << " (" << std::hex << R::hash(i) << std::dec << ")"
+                  << std::endl;
+    }
+}
+
+} // namespace t
+
+
+int main(void)
+{
+    using namespace t;
+    ////////////////////
+    // dense IDs
+    ////////////////////
+    static_assert(R1::size == 4);
+    static_assert(R1::id<Position>() < R1::size);
+    static_assert(R1::id<Position>() != R1::id<Velocity>());
+    static_assert(R1::contains<Health>());
+    static_assert(!R1::contains<int>());
+    // The IDs do not depend upon the declaration order.
+    static_assert(R1::id<Position>() == R2::id<Position>());
+    static_assert(R1::id<Velocity>() == R2::id<Velocity>());
+    static_assert(R1::id<Health>()   == R2::id<Health>());
+    static_assert(R1::id<Name>()     == R2::id<Name>());
+    static_assert(R1::name(R1::id<Name>()) == "t::Name");
+    static_assert(R1::hash(0) < R1::hash(1));
+    ////////////////////
+    // signature
+    ////////////////////
+    constexpr auto moving = R1::signature<Position, Velocity>();
+    constexpr auto living = R1::signature<Position, Velocity, Health>();
+    static_assert(moving.count() == 2);
+    static_assert(moving.test(R1::id<Position>()));
+    static_assert(!moving.test(R1::id<Health>()));
+    static_assert(living.contains(moving));
+    static_assert(!moving.contains(living));
+    static_assert(nsfx::component_signature_v<R1, Velocity, Position> ==
+                  moving);
+    show<R1>();
+    ////////////////////
+    // explicit names
+    ////////////////////
+    using R3 = nsfx::component_registry<Position, Renamed>;
+    static_assert(R3::name(R3::id<Renamed>()) == "game.Tag");
+    static_assert(R3::hash(R3::id<Renamed>()) ==
+                  nsfx::type_name<Renamed>::hash());
+
+    return 0;
+}
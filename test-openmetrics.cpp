@@ -0,0 +1,109 @@
+/**
+ * @file
+ *
+ * @brief OpenMetrics text exporter of per-type counters and histograms.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "openmetrics.hpp"
+
+namespace t {
+
+struct Ping {};
+template<char C> struct Quote {};
+
+struct tag {};
+struct quote_tag {};
+
+} // namespace t
+
+template<>
+struct nsfx::type_histogram_traits<t::tag>
+{
+    static constexpr std::uint64_t bounds[] = { 10, 100 };
+    static constexpr std::size_t capacity = 4;
+};
+
+
+int main(void)
+{
+    using namespace t;
+    int failures = 0;
+    auto check = [&](bool ok, const char* what) {
+        if (!ok)
+        {
+            std::cout << "FAILED: " << what << std::endl;
+            ++failures;
+        }
+    };
+    ////////////////////
+    // escape
+    ////////////////////
+    static_assert(nsfx::escape<nsfx::openmetrics>(
+                      nsfx::to_fixed_string("a\"b\\c\nd")).view() ==
+                  "a\\\"b\\\\c\\nd");
+    static_assert(nsfx::escaped_name_v<nsfx::openmetrics, Ping>.view() ==
+                  "t::Ping");
+    std::cout << nsfx::type_name<Quote<'"'>>::name() << " -> "
+              << nsfx::escaped_name_v<nsfx::openmetrics, Quote<'"'>>
+              << std::endl;
+    ////////////////////
+    // exporter
+    ////////////////////
+    nsfx::type_counter<Ping, tag>::add(3);
+    nsfx::type_histogram<Ping, tag>::observe(5);
+    nsfx::type_histogram<Ping, tag>::observe(50);
+    nsfx::type_histogram<Ping, tag>::observe(500);
+    nsfx::openmetrics_exporter e;
+    e.counters<tag>("messages", "Messages by type.");
+    e.histograms<tag>("size_bytes", "Sizes\nby type.");
+    std::string_view text = e.finish();
+    std::cout << text;
+    check(text ==
+          "# TYPE messages counter\n"
+          "# HELP messages Messages by type.\n"
+          "messages_total{type=\"t::Ping\"} 3\n"
+          "# TYPE size_bytes histogram\n"
+          "# HELP size_bytes Sizes\\nby type.\n"
+          "size_bytes_bucket{type=\"t::Ping\",le=\"10\"} 1\n"
+          "size_bytes_bucket{type=\"t::Ping\",le=\"100\"} 2\n"
+          "size_bytes_bucket{type=\"t::Ping\",le=\"+Inf\"} 3\n"
+          "size_bytes_count{type=\"t::Ping\"} 3\n"
+          "size_bytes_sum{type=\"t::Ping\"} 555\n"
+          "# EOF\n",
+          "exported text");
+    // The labels are the escaped names computed at compile time.
+    std::vector<nsfx::type_info_entry> entries;
+    std::vector<std::string_view> labels;
+    std::vector<std::uint64_t> counts;
+    nsfx::type_counters<tag>::load(entries, labels, counts);
+    check(labels.size() == 1 &&
+          labels[0].data() ==
+          nsfx::escaped_name_v<nsfx::openmetrics, Ping>.view().data(),
+          "precomputed label");
+    // The buffers are reused by the next scrape.
+    const char* data = text.data();
+    e.clear();
+    e.counters<tag>("messages", "Messages by type.");
+    e.histograms<tag>("size_bytes", "Sizes\nby type.");
+    check(e.finish().data() == data, "buffer is reused");
+    ////////////////////
+    // label escaping
+    ////////////////////
+    nsfx::type_counter<Quote<'"'>, quote_tag>::increment();
+    e.clear();
+    e.counters<quote_tag>("quotes", "Quotes by type.", "kind");
+    text = e.finish();
+    std::cout << text;
+    check(text.find("quotes_total{kind=\"t::Quote<'\\\\\\\"'>\"} 1\n") !=
+          text.npos, "escaped label");
+
+    return failures;
+}
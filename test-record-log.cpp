@@ -0,0 +1,222 @@
+/**
+ * @file
+ *
+ * @brief Memory-mapped reader of type-tagged record logs.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "record-log.hpp"
+#include "record-writer.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace t {
+
+struct ping
+{
+    std::uint32_t seq;
+};
+
+struct pong
+{
+    std::uint32_t seq;
+    std::uint32_t delay;
+};
+
+// A message with a variable-length payload.
+struct chat {};
+
+// A message that is never written.
+struct quit {};
+
+// A record that leaves a little more than a frame header in a block.
+struct large
+{
+    unsigned char data[4060];
+};
+
+struct tiny
+{
+    unsigned char data[1];
+};
+
+} // namespace t
+
+
+int main(void)
+{
+    using namespace t;
+    int failures = 0;
+    auto check = [&] (bool ok, const char* what) {
+        if (!ok)
+        {
+            std::cout << "FAILED: " << what << std::endl;
+            ++failures;
+        }
+    };
+    const std::string path = "test-record-log.bin";
+    constexpr std::size_t block = nsfx::record_writer::alignment;
+    constexpr std::uint32_t num_pings = 20000;
+    ////////////////////
+    // write
+    ////////////////////
+    {
+        const int fd = ::open(path.c_str(),
+                              O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        {
+            nsfx::record_writer w(fd, block, 2);
+            const std::string text(200, 'x');
+            for (std::uint32_t i = 0; i < num_pings; ++i)
+            {
+                w.write(ping{i});
+                if (i % 3 == 0)
+                {
+                    w.write(pong{i, i % 10});
+                }
+                if (i % 11 == 0)
+                {
+                    w.write<chat>(text.data(), i % 197);
+                }
+            }
+        }
+        // An incomplete record left by a crash.
+        unsigned char buf[64];
+        nsfx::typed_frame<pong>::write(buf, pong{0, 0});
+        check(::write(fd, buf, 20) == 20, "write incomplete");
+        ::close(fd);
+    }
+    ////////////////////
+    // read
+    ////////////////////
+    nsfx::record_log log(path.c_str());
+    check(!log.error(), "open");
+    check(!log.indexed(), "not indexed");
+    // Scan without an index.
+    std::uint32_t next = 0;
+    bool ordered = true;
+    std::size_t n = log.for_each<ping>([&] (const nsfx::frame_view& f) {
+        ping p;
+        ordered = ordered && f.load(p) && p.seq == next++;
+    });
+    check(n == num_pings && ordered, "scan pings");
+    // Index by a single thread.
+    check(!log.index(), "incomplete");
+    check(log.indexed(), "indexed");
+    check(log.valid_size() + 20 == log.size(), "valid size");
+    check(log.num_types() == 3, "types");
+    const auto pongs = log.offsets<pong>();
+    const auto chats = log.offsets<chat>();
+    check(pongs.size() == (num_pings + 2) / 3, "pongs");
+    check(chats.size() == (num_pings + 10) / 11, "chats");
+    check(log.offsets<quit>().empty(), "quit");
+    next = 0;
+    ordered = true;
+    n = log.for_each<pong>([&] (const nsfx::frame_view& f) {
+        pong p;
+        ordered = ordered && f.load(p) && p.seq == next && p.delay == next % 10;
+        next += 3;
+    });
+    check(n == pongs.size() && ordered, "indexed pongs");
+    // Zero copy.
+    check(log.at(chats[1]).payload_ ==
+          log.data() + chats[1] + nsfx::frame_header::size, "zero copy");
+    check(log.at(chats[1]).payload_len_ == 11, "chat length");
+    // Index by threads.
+    check(!log.index(4, block), "threads: incomplete");
+    check(log.offsets<pong>() == pongs, "threads: pongs");
+    check(log.offsets<chat>() == chats, "threads: chats");
+    check(log.valid_size() + 20 == log.size(), "threads: valid size");
+    // A wrong block size falls back to a single thread.
+    log.index(4, 1000);
+    check(log.offsets<pong>() == pongs, "fallback: pongs");
+    check(log.offsets<chat>() == chats, "fallback: chats");
+    std::cout << "log: " << log.size() << " bytes, "
+              << log.size() / block + 1 << " blocks" << std::endl;
+    std::remove(path.c_str());
+    ////////////////////
+    // records near the end of a block
+    ////////////////////
+    {
+        {
+            nsfx::record_writer w(path.c_str(), block, 2);
+            for (unsigned char i = 0; i < 5; ++i)
+            {
+                large l {};
+                l.data[0] = i;
+                // The tiny record would end 3 bytes before the boundary.
+                check(w.write(l) && w.write(tiny{{i}}), "write near end");
+            }
+        }
+        nsfx::record_log near(path.c_str());
+        auto count = [&] (void) {
+            std::size_t i = 0;
+            near.for_each<tiny>([&] (const nsfx::frame_view& f) {
+                tiny x;
+                check(f.load(x) && x.data[0] == i++, "near: order");
+            });
+            return i;
+        };
+        check(count() == 5, "near: scan");
+        check(near.index(), "near: complete");
+        check(count() == 5, "near: index");
+        check(near.offsets<large>().size() == 5, "near: large");
+        std::remove(path.c_str());
+    }
+    ////////////////////
+    // zeros at the end of a block, left by earlier writers
+    ////////////////////
+    {
+        std::vector<unsigned char> data(2 * block + 17);
+        unsigned char* p = data.data();
+        for (std::size_t b = 0; b < 2; ++b, p += block)
+        {
+            // 10 zeros are left in each block.
+            nsfx::write_frame_header(p, nsfx::frame_header{
+                nsfx::typed_frame<chat>::type_hash, block - 26});
+        }
+        nsfx::write_frame_header(p, nsfx::frame_header{
+            nsfx::typed_frame<tiny>::type_hash, 1});
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        check(f && std::fwrite(data.data(), 1, data.size(), f) == data.size(),
+              "write zeros");
+        std::fclose(f);
+        nsfx::record_log zeros(path.c_str());
+        check(zeros.for_each<tiny>([] (const nsfx::frame_view&) {}) == 1,
+              "zeros: scan");
+        check(zeros.index(), "zeros: complete");
+        check(zeros.offsets<chat>().size() == 2, "zeros: chats");
+        check(zeros.offsets<tiny>() ==
+              nsfx::record_log::offsets_type{2 * block}, "zeros: tiny");
+        // A gap that is not all zeros cannot be skipped.
+        data[block - 5] = 1;
+        f = std::fopen(path.c_str(), "wb");
+        check(f && std::fwrite(data.data(), 1, data.size(), f) == data.size(),
+              "write corrupt");
+        std::fclose(f);
+        nsfx::record_log corrupt(path.c_str());
+        check(!corrupt.index(), "corrupt: incomplete");
+        check(corrupt.valid_size() == block - 10, "corrupt: valid size");
+        std::remove(path.c_str());
+    }
+    ////////////////////
+    // failure
+    ////////////////////
+    {
+        nsfx::record_log missing("no-such-file.bin");
+        check(missing.error() == ENOENT, "missing");
+        missing.index(4, block);
+        check(missing.for_each<ping>([] (const nsfx::frame_view&) {}) == 0,
+              "missing: empty");
+    }
+
+    return failures;
+}
@@ -0,0 +1,218 @@
+/**
+ * @file
+ *
+ * @brief Batched writer of type-tagged records.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "record-writer.hpp"
+#include "record-log.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace t {
+
+struct ping
+{
+    std::uint32_t seq;
+};
+
+struct chat {};
+
+// A record that leaves a little more than a frame header in a block.
+struct large
+{
+    unsigned char data[4060];
+};
+
+// A record that would leave less than a frame header in a block.
+struct odd
+{
+    unsigned char data[4070];
+};
+
+struct tiny
+{
+    unsigned char data[1];
+};
+
+std::vector<unsigned char> read_file(const char* path)
+{
+    std::vector<unsigned char> data;
+    std::FILE* f = std::fopen(path, "rb");
+    if (!f)
+    {
+        return data;
+    }
+    unsigned char buf[4096];
+    std::size_t n;
+    while ((n = std::fread(buf, 1, sizeof (buf), f)) > 0)
+    {
+        data.insert(data.end(), buf, buf + n);
+    }
+    std::fclose(f);
+    return data;
+}
+
+} // namespace t
+
+
+int main(void)
+{
+    using namespace t;
+    int failures = 0;
+    auto check = [&] (bool ok, const char* what) {
+        if (!ok)
+        {
+            std::cout << "FAILED: " << what << std::endl;
+            ++failures;
+        }
+    };
+    const std::string path = "test-record-writer.bin";
+    constexpr std::size_t block = nsfx::record_writer::alignment;
+    constexpr std::uint32_t num_pings = 5000;
+    ////////////////////
+    // write
+    ////////////////////
+    {
+        // Small batches, so that several batches are written.
+        nsfx::record_writer w(path.c_str(), block, 2);
+        check(!w.error(), "open");
+        check(w.block_size() == block, "block size");
+        const std::string text(113, 'x');
+        for (std::uint32_t i = 0; i < num_pings; ++i)
+        {
+            check(w.write(ping{i}), "write ping");
+            if (i % 7 == 0)
+            {
+                check(w.write<chat>(text.data(), i % 113), "write chat");
+            }
+            // Records are appended to the current block after a flush.
+            if (i == num_pings / 2)
+            {
+                check(w.flush(), "flush");
+            }
+        }
+        // A record must fit in a block.
+        std::vector<char> huge(block);
+        check(!w.write<chat>(huge.data(), huge.size()), "reject huge");
+        check(w.write<chat>(huge.data(), block - nsfx::frame_header::size),
+              "write a full block");
+        check(!w.write(odd{}), "reject a gap shorter than a header");
+        check(!w.error(), "no error");
+    }
+    ////////////////////
+    // read back
+    ////////////////////
+    const std::vector<unsigned char> data = read_file(path.c_str());
+    std::remove(path.c_str());
+    nsfx::frame_reader r(data.data(), data.size());
+    nsfx::frame_view f;
+    std::uint32_t next = 0;
+    std::size_t chats = 0;
+    std::size_t full = 0;
+    bool ordered = true;
+    bool aligned = true;
+    while (r.next(f))
+    {
+        // A frame never crosses a block boundary.
+        const std::size_t end = r.consumed();
+        const std::size_t begin =
+            end - nsfx::frame_header::size - f.payload_len_;
+        aligned = aligned && begin / block == (end - 1) / block;
+        ping p;
+        if (f.load(p))
+        {
+            ordered = ordered && p.seq == next;
+            ++next;
+        }
+        else if (f.is<chat>())
+        {
+            f.payload_len_ == block - nsfx::frame_header::size ? ++full
+                                                               : ++chats;
+        }
+        else
+        {
+            check(f.type_hash_ == nsfx::padding_frame_hash, "padding");
+        }
+    }
+    check(r.consumed() == data.size(), "no partial frame");
+    check(ordered && next == num_pings, "pings");
+    check(chats == (num_pings + 6) / 7, "chats");
+    check(full == 1, "full block");
+    check(aligned, "frames within blocks");
+    ////////////////////
+    // records near the block size
+    ////////////////////
+    {
+        {
+            nsfx::record_writer w(path.c_str(), block, 2);
+            for (unsigned char i = 0; i < 10; ++i)
+            {
+                large l {};
+                l.data[0] = i;
+                check(w.write(l) && w.write(tiny{{i}}), "write large");
+            }
+        }
+        nsfx::record_log log(path.c_str());
+        for (std::size_t threads : {1, 3})
+        {
+            log.index(threads, block);
+            check(log.valid_size() == log.size(), "read large");
+            std::size_t i = 0;
+            log.for_each<large>([&] (const nsfx::frame_view& v) {
+                large l;
+                check(v.load(l) && l.data[0] == i++, "large");
+            });
+            i = 0;
+            log.for_each<tiny>([&] (const nsfx::frame_view& v) {
+                tiny t;
+                check(v.load(t) && t.data[0] == i++, "tiny");
+            });
+            check(i == 10, "tiny count");
+        }
+        std::remove(path.c_str());
+    }
+    ////////////////////
+    // more blocks than IOV_MAX
+    ////////////////////
+    {
+        constexpr std::size_t num_blocks = IOV_MAX + 8;
+        {
+            nsfx::record_writer w(path.c_str(), block, num_blocks);
+            const std::vector<char> payload(block - nsfx::frame_header::size);
+            for (std::size_t i = 0; i < num_blocks; ++i)
+            {
+                check(w.write<chat>(payload.data(), payload.size()),
+                      "write a block");
+            }
+            check(!w.error(), "batch");
+            check(w.offset() == num_blocks * block, "batch offset");
+        }
+        check(read_file(path.c_str()).size() == num_blocks * block,
+              "batch size");
+        std::remove(path.c_str());
+    }
+    ////////////////////
+    // failure
+    ////////////////////
+    {
+        nsfx::record_writer w("no-such-dir/test-record-writer.bin");
+        check(w.error() != 0, "open failure");
+        check(!w.write(ping{0}), "write after failure");
+        check(!w.flush(), "flush after failure");
+    }
+
+    std::cout << "records: " << data.size() << " bytes" << std::endl;
+
+    return failures;
+}
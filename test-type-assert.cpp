@@ -0,0 +1,53 @@
+/**
+ * @file
+ *
+ * @brief Static assertions with type names in the diagnostics.
+ *
+ * Define `TYPE_ASSERT_EXPECT_FAILURE` to compile a failing assertion.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "type-assert.hpp"
+
+namespace t {
+
+template<class T>
+struct box {};
+
+} // namespace t
+
+
+int main(void)
+{
+    using namespace t;
+    ////////////////////
+    // first_difference
+    ////////////////////
+    static_assert(nsfx::first_difference("abc", "abd") == 2);
+    static_assert(nsfx::first_difference("ab", "abc") == 2);
+    static_assert(nsfx::first_difference("abc", "abc") ==
+                  std::string_view::npos);
+    ////////////////////
+    // static_assert_same
+    ////////////////////
+    static_assert(nsfx::static_assert_same<int, int>());
+    static_assert(nsfx::static_assert_same<box<const int&>,
+                                           box<const int&>>());
+    static_assert(std::is_same_v<
+        nsfx::details::type_assert::name_chars<box<int>>,
+        nsfx::details::type_assert::chars<'t', ':', ':', 'b', 'o', 'x',
+                                          '<', 'i', 'n', 't', '>'>>);
+#if defined(TYPE_ASSERT_EXPECT_FAILURE)
+    static_assert(nsfx::static_assert_same<box<const int&>,
+                                           box<const long&>>());
+#endif // defined(TYPE_ASSERT_EXPECT_FAILURE)
+
+    return 0;
+}
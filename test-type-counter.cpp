@@ -0,0 +1,118 @@
+/**
+ * @file
+ *
+ * @brief Per-type counters with lock-free increments.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "type-counter.hpp"
+
+#include <cstdlib>
+#include <thread>
+
+namespace t {
+
+struct Ping {};
+struct Pong {};
+struct Unused {};
+
+struct tag {};
+struct small {};
+
+// A snapshot at exit, after the thread-local objects have been destroyed.
+void snapshot_at_exit(void)
+{
+    if (nsfx::type_counters<tag>::snapshot().size() != 2)
+    {
+        std::cout << "FAILED: snapshot at exit" << std::endl;
+        std::_Exit(1);
+    }
+}
+
+} // namespace t
+
+template<>
+struct nsfx::type_counter_traits<t::small>
+{
+    static constexpr std::size_t capacity = 1;
+};
+
+
+int main(void)
+{
+    using namespace t;
+    int failures = 0;
+    auto check = [&](bool ok, const char* what) {
+        if (!ok)
+        {
+            std::cout << "FAILED: " << what << std::endl;
+            ++failures;
+        }
+    };
+    std::atexit(snapshot_at_exit);
+    ////////////////////
+    // type_id
+    ////////////////////
+    check(nsfx::type_id<Ping, tag>::value != nsfx::type_id<Pong, tag>::value,
+          "distinct IDs");
+    check(nsfx::type_registry<tag>::name(nsfx::type_id<Pong, tag>::value) ==
+          "t::Pong", "registered name");
+    ////////////////////
+    // type_counter
+    ////////////////////
+    constexpr int num_threads = 8;
+    constexpr int num_increments = 100000;
+    {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < num_threads; ++i)
+        {
+            threads.emplace_back([] {
+                for (int k = 0; k < num_increments; ++k)
+                {
+                    nsfx::type_counter<Ping, tag>::increment();
+                }
+                nsfx::type_counter<Pong, tag>::add(3);
+            });
+        }
+        for (auto& th : threads)
+        {
+            th.join();
+        }
+    }
+    // The counts of exited threads are retired.
+    check(nsfx::type_counter<Ping, tag>::load() ==
+          std::uint64_t{num_threads} * num_increments, "Ping count");
+    check(nsfx::type_counter<Pong, tag>::load() == 3 * num_threads,
+          "Pong count");
+    // The counts of the living threads.
+    nsfx::type_counter<Pong, tag>::increment();
+    check(nsfx::type_counter<Pong, tag>::load() == 3 * num_threads + 1,
+          "Pong count of the living thread");
+    ////////////////////
+    // type_counters
+    ////////////////////
+    auto snapshot = nsfx::type_counters<tag>::snapshot();
+    check(snapshot.size() == 2, "snapshot size");
+    for (const auto& c : snapshot)
+    {
+        std::cout << c.id_ << ": " << c.name_ << " (" << c.base_ << ") = "
+                  << c.count_ << std::endl;
+    }
+    ////////////////////
+    // overflow
+    ////////////////////
+    nsfx::type_counter<Ping, small>::increment();
+    nsfx::type_counter<Pong, small>::add(2);
+    check(nsfx::type_counters<small>::snapshot().size() == 1,
+          "snapshot is limited by the capacity");
+    check(nsfx::type_counters<small>::overflow() == 2, "overflow count");
+
+    return failures;
+}
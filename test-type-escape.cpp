@@ -0,0 +1,83 @@
+/**
+ * @file
+ *
+ * @brief Escape type names at compile time.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "type-escape.hpp"
+
+namespace t {
+
+template<class T, class U>
+struct pair {};
+
+template<char C>
+struct ch {};
+
+template<class Format, class T>
+void show(const char* format)
+{
+    std::cout << format << ": " << nsfx::escaped_name_v<Format, T>
+              << std::endl;
+}
+
+} // namespace t
+
+
+int main(void)
+{
+    using namespace t;
+    using nsfx::to_fixed_string;
+    using P = pair<int, const char*>;
+    ////////////////////
+    // json
+    ////////////////////
+    static_assert(nsfx::escape<nsfx::json>(
+                      to_fixed_string("a\"b\\c\n\x01")).view() ==
+                  "a\\\"b\\\\c\\n\\u0001");
+    static_assert(nsfx::escaped_name_v<nsfx::json, P>.view() ==
+                  "t::pair<int, const char*>");
+    ////////////////////
+    // xml
+    ////////////////////
+    static_assert(nsfx::escape<nsfx::xml>(
+                      to_fixed_string("<a & 'b'>\"")).view() ==
+                  "&lt;a &amp; &apos;b&apos;&gt;&quot;");
+    static_assert(nsfx::escaped_name_v<nsfx::xml, P>.view() ==
+                  "t::pair&lt;int, const char*&gt;");
+    ////////////////////
+    // csv
+    ////////////////////
+    static_assert(nsfx::escape<nsfx::csv>(
+                      to_fixed_string("a, \"b\"")).view() ==
+                  "\"a, \"\"b\"\"\"");
+    static_assert(nsfx::escaped_name_v<nsfx::csv, P>.view() ==
+                  "\"t::pair<int, const char*>\"");
+    ////////////////////
+    // shell
+    ////////////////////
+    static_assert(nsfx::escape<nsfx::shell>(
+                      to_fixed_string("a <b> & 'c'")).view() ==
+                  "'a <b> & '\\''c'\\'''");
+    static_assert(nsfx::escaped_name_v<nsfx::shell, P>.view() ==
+                  "'t::pair<int, const char*>'");
+    ////////////////////
+    // The escaped names are trimmed.
+    ////////////////////
+    static_assert(nsfx::escaped_name_v<nsfx::xml, P>.capacity_ ==
+                  nsfx::escaped_name_v<nsfx::xml, P>.size_ + 1);
+    show<nsfx::json,  ch<'"'>>("json ");
+    show<nsfx::xml,   ch<'"'>>("xml  ");
+    show<nsfx::csv,   ch<'"'>>("csv  ");
+    show<nsfx::shell, ch<'\''>>("shell");
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file
+ *
+ * @brief Per-type log levels configured by type-name patterns.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "type-filter.hpp"
+
+#include <thread>
+
+namespace net {
+
+struct session {};
+struct socket {};
+
+namespace codec {
+
+struct frame {};
+
+} // namespace codec
+} // namespace net
+
+namespace app {
+
+struct main_loop {};
+
+} // namespace app
+
+namespace t {
+
+struct small {};
+
+// The domain of the checks within static initializers.
+struct early {};
+
+// Checked before it is registered.
+struct late {};
+
+} // namespace t
+
+namespace nsfx {
+
+// A domain that holds a single type.
+template<>
+struct type_filter_traits<t::small>
+{
+    static constexpr std::size_t capacity = 1;
+    static constexpr log_level default_level = log_level::warning;
+};
+
+} // namespace nsfx
+
+namespace t {
+
+using early_filter = nsfx::type_filter<early>;
+
+// The ID of `late` as seen by a static initializer.
+std::size_t late_id = 0;
+
+// A check within the initializer of a static variable, which precedes the
+// dynamic initialization of the index of `late` in practice, though the
+// order is unspecified.
+const bool late_enabled = [] {
+    late_id = early_filter::id<late>();
+    // Another type takes the first ID, and its threshold is set.
+    early_filter::registry_type::add(
+        nsfx::type_info_entry{"t::first", "first", 1});
+    early_filter::configure({{"t::first", nsfx::log_level::off}});
+    return early_filter::enabled<late>(nsfx::log_level::info);
+}();
+
+} // namespace t
+
+
+int main(void)
+{
+    using nsfx::log_level;
+    int failures = 0;
+    auto check = [&] (bool ok, const char* what) {
+        if (!ok)
+        {
+            std::cout << "FAILED: " << what << std::endl;
+            ++failures;
+        }
+    };
+    using filter = nsfx::type_filter<>;
+    ////////////////////
+    // default
+    ////////////////////
+    check(filter::threshold<net::session>() == log_level::info, "default");
+    check( filter::enabled<net::session>(log_level::info), "default: info");
+    check(!filter::enabled<net::session>(log_level::debug), "default: debug");
+    ////////////////////
+    // rules
+    ////////////////////
+    // Register the types, as the log statements would.
+    filter::id<net::socket>();
+    filter::id<net::codec::frame>();
+    filter::id<app::main_loop>();
+    const std::size_t matched = filter::configure({
+        {"net::*", log_level::debug},
+        {"net::codec::*", log_level::off},
+        {"*::main_loop", log_level::trace},
+    });
+    check(matched == 4, "matched");
+    check(filter::enabled<net::session>(log_level::debug), "net: debug");
+    check(!filter::enabled<net::session>(log_level::trace), "net: trace");
+    check(filter::enabled<net::socket>(log_level::debug), "socket: debug");
+    // The last matching rule wins.
+    check(!filter::enabled<net::codec::frame>(log_level::fatal),
+          "codec: off");
+    check(filter::enabled<app::main_loop>(log_level::trace), "app: trace");
+    // Reconfigure from another thread.
+    std::thread([] {
+        filter::configure({{"app::*", log_level::error}});
+    }).join();
+    check(filter::threshold<net::session>() == log_level::info,
+          "reconfigure: default");
+    check(!filter::enabled<app::main_loop>(log_level::warning),
+          "reconfigure: app");
+    ////////////////////
+    // set and reset
+    ////////////////////
+    filter::set<net::codec::frame>(log_level::trace);
+    check(filter::enabled<net::codec::frame>(log_level::trace), "set");
+    filter::reset();
+    check(filter::threshold<net::codec::frame>() == log_level::info &&
+          filter::threshold<app::main_loop>() == log_level::info, "reset");
+    ////////////////////
+    // capacity
+    ////////////////////
+    using small = nsfx::type_filter<t::small>;
+    small::set<net::session>(log_level::trace);
+    small::set<net::socket>(log_level::trace);
+    // The order of the registration is unspecified.
+    check(small::enabled<net::session>(log_level::trace) +
+          small::enabled<net::socket>(log_level::trace) == 1,
+          "small: beyond capacity");
+    check(small::threshold<net::session>() == log_level::warning ||
+          small::threshold<net::socket>() == log_level::warning,
+          "small: default");
+    ////////////////////
+    // static initialization
+    ////////////////////
+    // The unregistered type gets the default threshold, rather than the
+    // threshold of the first type.
+    check(t::late_enabled, "early: default");
+    check(t::early_filter::enabled<t::late>(log_level::info), "early: late");
+    if (t::late_id == static_cast<std::size_t>(-1))
+    {
+        check(t::early_filter::id<t::late>() == 1, "early: registered later");
+    }
+    else
+    {
+        std::cout << "early: registered before the check" << std::endl;
+    }
+    std::cout << filter::registry_type::size() << " types" << std::endl;
+
+    return failures;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file
+ *
+ * @brief Match type names against glob patterns.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "type-glob.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns {
+namespace detail {
+
+struct impl {};
+
+template<class T>
+struct node {};
+
+} // namespace detail
+
+struct api {};
+
+} // namespace ns
+
+
+int main(void)
+{
+    int failures = 0;
+    auto check = [&] (bool ok, const char* what) {
+        if (!ok)
+        {
+            std::cout << "FAILED: " << what << std::endl;
+            ++failures;
+        }
+    };
+    ////////////////////
+    // compile time
+    ////////////////////
+    static_assert(nsfx::glob_match("", ""));
+    static_assert(nsfx::glob_match("*", ""));
+    static_assert(!nsfx::glob_match("?", ""));
+    static_assert(nsfx::glob_match("a*b*c", "aXbYbZc"));
+    static_assert(!nsfx::glob_match("a*b*c", "aXbYbZ"));
+    static_assert(nsfx::glob_match("a\\*", "a*"));
+    static_assert(!nsfx::glob_match("a\\*", "ab"));
+    static_assert(nsfx::glob_match("a\\?\\\\", "a?\\"));
+    static_assert(nsfx::type_glob_match<ns::detail::impl>("ns::detail::*"));
+    static_assert(nsfx::type_glob_match<ns::detail::node<int>>(
+        "ns::detail::*"));
+    static_assert(!nsfx::type_glob_match<ns::api>("ns::detail::*"));
+    static_assert(nsfx::type_glob_match<ns::detail::node<ns::api>>(
+        "*<ns::api>"));
+    static_assert(nsfx::type_glob_match<std::vector<int>>("std::vector<*>"));
+    static_assert(!nsfx::type_glob_match<std::map<int, int>>(
+        "std::vector<*>"));
+    static_assert(nsfx::type_glob_match<ns::api>("ns::a?i"));
+    ////////////////////
+    // DFA
+    ////////////////////
+    {
+        nsfx::type_glob g("ns::detail::*");
+        check(g.num_patterns() == 1, "patterns");
+        check(g.matches<ns::detail::impl>(), "detail");
+        check(g.matches<ns::detail::node<int>>(), "detail template");
+        check(!g.matches<ns::api>(), "api");
+        check(!g.matches("ns::detail"), "prefix");
+        check(g.matches("ns::detail::"), "empty star");
+    }
+    {
+        // The last matching pattern wins.
+        nsfx::type_glob g({"ns::*", "std::vector<*>", "ns::detail::*",
+                           "*::impl"});
+        check(g.match(nsfx::type_name_v<ns::api>.view()) == 0, "multi: api");
+        check(g.match(nsfx::type_name_v<ns::detail::node<int>>.view()) == 2,
+              "multi: node");
+        check(g.match(nsfx::type_name_v<ns::detail::impl>.view()) == 3,
+              "multi: impl");
+        check(g.match(nsfx::type_name_v<std::vector<int>>.view()) == 1,
+              "multi: vector");
+        check(g.match("int") == nsfx::type_glob::npos, "multi: none");
+        std::cout << "states: " << g.num_states() << std::endl;
+    }
+    {
+        nsfx::type_glob none(std::vector<std::string_view>{});
+        check(!none.matches("") && !none.matches("x"), "no pattern");
+    }
+    ////////////////////
+    // DFA agrees with glob_match()
+    ////////////////////
+    const std::vector<std::string_view> patterns = {
+        "", "*", "?", "a", "a*", "*a", "*a*", "a*b", "a?b", "*a*b*",
+        "a*a*a", "?*?", "\\*", "a\\?*", "**b", "*ab*ba*", "b*?",
+    };
+    // All strings over {a, b, *, ?} up to length 5.
+    std::vector<std::string> strs(1);
+    for (std::size_t k = 0; k < strs.size() && strs[k].size() < 5; ++k)
+    {
+        for (const char c : {'a', 'b', '*', '?'})
+        {
+            strs.push_back(strs[k] + c);
+        }
+    }
+    nsfx::type_glob all(patterns);
+    std::size_t mismatches = 0;
+    for (std::size_t p = 0; p < patterns.size(); ++p)
+    {
+        nsfx::type_glob g(patterns[p]);
+        for (const std::string& s : strs)
+        {
+            mismatches += g.matches(s) != nsfx::glob_match(patterns[p], s);
+        }
+    }
+    for (const std::string& s : strs)
+    {
+        std::size_t expected = nsfx::type_glob::npos;
+        for (std::size_t p = 0; p < patterns.size(); ++p)
+        {
+            if (nsfx::glob_match(patterns[p], s))
+            {
+                expected = p;
+            }
+        }
+        mismatches += all.match(s) != expected;
+    }
+    check(mismatches == 0, "DFA vs glob_match");
+    std::cout << strs.size() << " strings, " << all.num_states()
+              << " states" << std::endl;
+
+    return failures;
+}
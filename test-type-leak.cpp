@@ -0,0 +1,160 @@
+/**
+ * @file
+ *
+ * @brief Report the live objects of the type pools by type name.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "type-leak.hpp"
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+namespace t {
+
+struct session
+{
+    char data[100];
+};
+
+struct buffer
+{
+    char data[24];
+};
+
+namespace v2 {
+
+struct buffer
+{
+    char data[40];
+};
+
+} // namespace v2
+
+// Released before the report.
+struct temporary
+{
+    int x;
+};
+
+// Released by the destructor of a static object.
+struct held
+{
+    int x;
+};
+
+struct holder
+{
+    held* p_ = nsfx::type_pool<held>::create();
+
+    ~holder(void)
+    {
+        nsfx::type_pool<held>::destroy(p_);
+    }
+};
+
+// The stream of the report at exit, which outlives the report.
+std::ostringstream& at_exit_stream(void)
+{
+    static std::ostringstream os;
+    return os;
+}
+
+// Runs after the report at exit.
+void check_at_exit(void)
+{
+    const std::string report = at_exit_stream().str();
+    std::cout << report;
+    if (report.find("t::session") == std::string::npos ||
+        report.find("t::held") != std::string::npos)
+    {
+        std::cout << "FAILED: report at exit" << std::endl;
+        std::_Exit(1);
+    }
+}
+
+} // namespace t
+
+
+int main(void)
+{
+    using namespace t;
+    int failures = 0;
+    auto check = [&] (bool ok, const char* what) {
+        if (!ok)
+        {
+            std::cout << "FAILED: " << what << std::endl;
+            ++failures;
+        }
+    };
+    at_exit_stream();
+    std::atexit(check_at_exit);
+    check(nsfx::type_leaks::report_at_exit(std::cout), "enable");
+    check(!nsfx::type_leaks::report_at_exit(at_exit_stream()),
+          "enable again");
+    ////////////////////
+    // leaks
+    ////////////////////
+    for (int i = 0; i < 3; ++i)
+    {
+        nsfx::type_pool<session>::create();
+    }
+    for (int i = 0; i < 10; ++i)
+    {
+        nsfx::type_pool<buffer>::create();
+        nsfx::type_pool<v2::buffer>::create();
+    }
+    nsfx::type_pool<temporary>::destroy(nsfx::type_pool<temporary>::create());
+    ////////////////////
+    // by name
+    ////////////////////
+    {
+        auto leaks = nsfx::type_leaks::collect();
+        check(leaks.size() == 3, "name: groups");
+        check(leaks.size() == 3 && leaks[0].name_ == "t::v2::buffer" &&
+              leaks[0].objects_ == 10 && leaks[0].bytes_ == 400,
+              "name: first");
+        check(leaks.size() == 3 && leaks[1].name_ == "t::session" &&
+              leaks[1].bytes_ == 312, "name: second");
+        check(leaks.size() == 3 && leaks[2].name_ == "t::buffer" &&
+              leaks[2].bytes_ == 240, "name: third");
+    }
+    ////////////////////
+    // by base
+    ////////////////////
+    {
+        auto leaks = nsfx::type_leaks::collect(nsfx::leak_grouping::base);
+        check(leaks.size() == 2, "base: groups");
+        check(leaks.size() == 2 && leaks[0].name_ == "buffer" &&
+              leaks[0].objects_ == 20 && leaks[0].bytes_ == 640,
+              "base: first");
+        check(leaks.size() == 2 && leaks[1].name_ == "session",
+              "base: second");
+    }
+    ////////////////////
+    // report
+    ////////////////////
+    {
+        std::ostringstream os;
+        check(nsfx::type_leaks::report(os) == 952, "report: bytes");
+        check(os.str().find("3 types, 23 objects, 952 bytes") !=
+              std::string::npos, "report: summary");
+        check(os.str().find("t::temporary") == std::string::npos,
+              "report: released");
+    }
+    // Constructed after the report is enabled, thus destroyed before the
+    // report at exit.
+    static holder h;
+    check(nsfx::type_pool<held>::stats().live_ == 1, "held");
+    // The report follows at exit.
+
+    return failures;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file
+ *
+ * @brief Flat maps keyed by types.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "type-map.hpp"
+
+#include <memory>
+#include <string>
+
+namespace t {
+
+struct logger {};
+struct timer {};
+struct config {};
+
+template<int I>
+struct service {};
+
+struct left {};
+struct right {};
+
+} // namespace t
+
+namespace nsfx {
+
+// Types whose hashes collide in every table size.
+template<int I>
+struct type_name_override<t::service<I>>
+{
+    static constexpr std::string_view name = "t::service";
+    static constexpr std::uint64_t hash = 0x1000000000000ull * (I + 1);
+};
+
+// Distinct types with the same hash.
+template<>
+struct type_name_override<t::left>
+{
+    static constexpr std::string_view name = "t::left";
+    static constexpr std::uint64_t hash = 0x42;
+};
+
+template<>
+struct type_name_override<t::right>
+{
+    static constexpr std::string_view name = "t::right";
+    static constexpr std::uint64_t hash = 0x42;
+};
+
+} // namespace nsfx
+
+
+int main(void)
+{
+    using namespace t;
+    int failures = 0;
+    auto check = [&] (bool ok, const char* what) {
+        if (!ok)
+        {
+            std::cout << "FAILED: " << what << std::endl;
+            ++failures;
+        }
+    };
+    ////////////////////
+    // insert and find
+    ////////////////////
+    {
+        nsfx::type_map<std::string> m;
+        check(m.empty() && !m.contains<logger>(), "empty");
+        m.insert_or_assign<logger>("log");
+        m.insert_or_assign<timer>(std::string("timer"));
+        check(m.size() == 2, "size");
+        check(m.get<logger>() == "log", "get logger");
+        check(m.get<timer>() == "timer", "get timer");
+        check(m.find<config>() == nullptr, "find missing");
+        m.insert_or_assign<logger>("log2");
+        check(m.size() == 2 && m.get<logger>() == "log2", "assign");
+        m.operator()<config>() += "cfg";
+        check(m.size() == 3 && m.get<config>() == "cfg", "default insert");
+        const auto& c = m;
+        check(*c.find<timer>() == "timer", "const find");
+        check(m.erase<timer>() && !m.erase<timer>(), "erase");
+        check(m.size() == 2 && !m.contains<timer>(), "erased");
+        std::size_t n = 0;
+        m.for_each([&] (std::uint64_t key, const std::string& v) {
+            n += key == nsfx::type_name<logger>::hash() && v == "log2";
+            n += key == nsfx::type_name<config>::hash() && v == "cfg";
+        });
+        check(n == 2, "for_each");
+        m.clear();
+        check(m.empty() && !m.contains<logger>(), "clear");
+    }
+    ////////////////////
+    // collisions and growth
+    ////////////////////
+    {
+        nsfx::type_map<std::unique_ptr<int>> m;
+        m.insert_or_assign<service<0>>(std::make_unique<int>(0));
+        m.insert_or_assign<service<1>>(std::make_unique<int>(1));
+        m.insert_or_assign<service<2>>(std::make_unique<int>(2));
+        m.insert_or_assign<service<3>>(std::make_unique<int>(3));
+        check(*m.get<service<2>>() == 2, "collision");
+        // Erase from the middle of the cluster.
+        check(m.erase<service<1>>(), "collision: erase");
+        check(*m.get<service<0>>() == 0 && *m.get<service<2>>() == 2 &&
+              *m.get<service<3>>() == 3 && !m.contains<service<1>>(),
+              "collision: after erase");
+        m.insert_or_assign<service<1>>(std::make_unique<int>(10));
+        // Grow beyond the initial slots.
+        m.insert_or_assign<service<4>>(std::make_unique<int>(4));
+        m.insert_or_assign<service<5>>(std::make_unique<int>(5));
+        m.insert_or_assign<service<6>>(std::make_unique<int>(6));
+        m.insert_or_assign<service<7>>(std::make_unique<int>(7));
+        m.insert_or_assign<service<8>>(std::make_unique<int>(8));
+        m.insert_or_assign<logger>(std::make_unique<int>(100));
+        check(m.size() == 10, "grow: size");
+        check(*m.get<service<1>>() == 10 && *m.get<service<8>>() == 8 &&
+              *m.get<logger>() == 100, "grow: get");
+        // Another map of the same value type holds the type in another slot.
+        nsfx::type_map<std::unique_ptr<int>> other;
+        check(!other.contains<service<8>>(), "other: missing");
+        other.insert_or_assign<service<8>>(std::make_unique<int>(80));
+        check(*other.get<service<8>>() == 80 && *m.get<service<8>>() == 8,
+              "other: separate");
+    }
+    ////////////////////
+    // equal hashes
+    ////////////////////
+    {
+        nsfx::type_map<int> m;
+        m.insert_or_assign<left>(1);
+        check(!m.contains<right>(), "equal hashes: missing");
+        m.insert_or_assign<right>(2);
+        check(m.size() == 2 && m.get<left>() == 1 && m.get<right>() == 2,
+              "equal hashes: apart");
+        check(m.erase<left>() && !m.contains<left>() && m.get<right>() == 2,
+              "equal hashes: erase");
+    }
+
+    return failures;
+}
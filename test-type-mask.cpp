@@ -0,0 +1,94 @@
+/**
+ * @file
+ *
+ * @brief Bitmasks of type sets at compile time.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "type-mask.hpp"
+
+namespace t {
+
+struct ping {};
+struct pong {};
+struct chat {};
+struct quit {};
+
+template<int I> struct msg {};
+
+template<int... Is>
+using messages_of = nsfx::type_list<msg<Is>...>;
+
+} // namespace t
+
+
+int main(void)
+{
+    using namespace t;
+    int failures = 0;
+    auto check = [&] (bool ok, const char* what) {
+        if (!ok)
+        {
+            std::cout << "FAILED: " << what << std::endl;
+            ++failures;
+        }
+    };
+    using nsfx::type_list;
+    using messages = type_list<ping, pong, chat, quit>;
+    using universe = nsfx::type_universe<messages>;
+    ////////////////////
+    // positions
+    ////////////////////
+    static_assert(universe::size == 4);
+    static_assert(universe::position<chat>() == 0);
+    static_assert(universe::position<ping>() == 1);
+    static_assert(universe::position<pong>() == 2);
+    static_assert(universe::position<quit>() == 3);
+    static_assert(universe::name(1) == "t::ping");
+    // The positions do not depend upon the declaration order.
+    static_assert(nsfx::type_universe<type_list<quit, pong, ping, chat>>
+                  ::position<ping>() == 1);
+    ////////////////////
+    // masks
+    ////////////////////
+    constexpr auto wanted = nsfx::type_mask_v<messages, ping, quit>;
+    static_assert(wanted.words_[0] == 0b1010);
+    static_assert( universe::test<ping>(wanted));
+    static_assert(!universe::test<pong>(wanted));
+    static_assert(nsfx::type_mask_v<messages>.none());
+    static_assert(nsfx::type_mask_v<type_list<quit, pong, ping, chat>,
+                                    quit, ping> == wanted);
+    // Combine masks at run time.
+    auto subscribed = wanted | universe::mask<chat>();
+    check(universe::test<chat>(subscribed), "combined");
+    check(subscribed.count() == 3, "count");
+    check(subscribed.to_bitset().to_string() == "1011", "to_bitset");
+    ////////////////////
+    // many types
+    ////////////////////
+    using large = nsfx::type_universe<messages_of<
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+        20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36,
+        37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53,
+        54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69>>;
+    static_assert(large::bitset_type::num_words == 2);
+    constexpr auto high = large::mask<msg<69>, msg<7>>();
+    static_assert(high.count() == 2);
+    static_assert(large::test<msg<69>>(high) && !large::test<msg<6>>(high));
+    for (std::size_t i = 0; i < large::size; ++i)
+    {
+        if (high.test(i))
+        {
+            std::cout << i << ": " << large::name(i) << std::endl;
+        }
+    }
+
+    return failures;
+}
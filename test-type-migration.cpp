@@ -0,0 +1,181 @@
+/**
+ * @file
+ *
+ * @brief Lazy migration of persisted types by versioned hashes.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "type-migration.hpp"
+
+#include <cstring>
+#include <vector>
+
+namespace t {
+
+// The layouts of the older versions.
+struct record_v1
+{
+    std::int32_t id;
+};
+
+struct record_v2
+{
+    std::int32_t id;
+    std::int32_t score;
+};
+
+// The current version.
+struct record
+{
+    std::int64_t id;
+    std::int64_t score;
+    std::int64_t rank;
+};
+
+} // namespace t
+
+template<>
+struct nsfx::type_version<t::record>
+    : std::integral_constant<std::uint32_t, 3> {};
+
+namespace t {
+
+template<class L>
+bool load(const void* data, std::size_t size, L& old)
+{
+    if (size != sizeof (L))
+    {
+        return false;
+    }
+    std::memcpy(&old, data, size);
+    return true;
+}
+
+bool from_v1(const void* data, std::size_t size, record& out)
+{
+    record_v1 old;
+    if (!load(data, size, old))
+    {
+        return false;
+    }
+    out = record{old.id, 0, -1};
+    return true;
+}
+
+bool from_v2(const void* data, std::size_t size, record& out)
+{
+    record_v2 old;
+    if (!load(data, size, old))
+    {
+        return false;
+    }
+    out = record{old.id, old.score, -1};
+    return true;
+}
+
+constexpr auto table = nsfx::make_migration_table<record>(
+    nsfx::migrate_from<record, 1>(&from_v1),
+    nsfx::migrate_from<record, 2>(&from_v2));
+
+// A store that keys blobs by type hashes.
+using blob = std::pair<std::uint64_t, std::vector<char>>;
+
+template<class L>
+blob save(std::uint64_t hash, const L& value)
+{
+    const char* p = reinterpret_cast<const char*>(&value);
+    return blob{hash, std::vector<char>(p, p + sizeof (L))};
+}
+
+} // namespace t
+
+
+int main(void)
+{
+    using namespace t;
+    int failures = 0;
+    auto check = [&] (bool ok, const char* what) {
+        if (!ok)
+        {
+            std::cout << "FAILED: " << what << std::endl;
+            ++failures;
+        }
+    };
+    ////////////////////
+    // versioned names
+    ////////////////////
+    static_assert(nsfx::type_version_v<record> == 3);
+    static_assert(nsfx::type_version_v<record_v1> == 0);
+    static_assert(nsfx::type_name<record>::versioned().view() ==
+                  "t::record@3");
+    static_assert(nsfx::type_name<record>::versioned<1>().view() ==
+                  "t::record@1");
+    static_assert(nsfx::type_name<record>::versioned<0>().view() ==
+                  "t::record");
+    static_assert(nsfx::type_name<record>::versioned_hash<0>() ==
+                  nsfx::type_name<record>::hash());
+    static_assert(nsfx::type_name<record>::versioned_hash() !=
+                  nsfx::type_name<record>::versioned_hash<2>());
+    ////////////////////
+    // migration table
+    ////////////////////
+    static_assert(table.unique());
+    static_assert(table.current == nsfx::type_name<record>::versioned_hash());
+    static_assert(table.knows(nsfx::type_name<record>::versioned_hash<1>()));
+    static_assert(!table.knows(nsfx::type_name<record>::versioned_hash<4>()));
+    static_assert(table.find(nsfx::type_name<record>::versioned_hash<2>())
+                  ->version_ == 2);
+    // A type without older versions.
+    constexpr auto none = nsfx::make_migration_table<record_v1>();
+    static_assert(none.unique());
+    static_assert(none.knows(nsfx::type_name<record_v1>::hash()));
+    static_assert(!none.find(nsfx::type_name<record_v1>::versioned_hash<1>()));
+
+    std::vector<blob> store;
+    store.push_back(save(nsfx::type_name<record>::versioned_hash<1>(),
+                         record_v1{1}));
+    store.push_back(save(nsfx::type_name<record>::versioned_hash<2>(),
+                         record_v2{2, 20}));
+    store.push_back(save(nsfx::type_name<record>::versioned_hash(),
+                         record{3, 30, 300}));
+    store.push_back(save(nsfx::type_name<record_v1>::hash(), record_v1{4}));
+
+    std::vector<record> loaded;
+    std::size_t migrated = 0;
+    for (const auto& [hash, bytes] : store)
+    {
+        record r {};
+        if (hash == table.current)
+        {
+            check(load(bytes.data(), bytes.size(), r), "current");
+            loaded.push_back(r);
+        }
+        else if (table.migrate(hash, bytes.data(), bytes.size(), r))
+        {
+            loaded.push_back(r);
+            ++migrated;
+        }
+    }
+    check(loaded.size() == 3, "loaded");
+    check(migrated == 2, "migrated");
+    check(loaded.size() == 3 && loaded[0].id == 1 && loaded[0].rank == -1,
+          "from v1");
+    check(loaded.size() == 3 && loaded[1].score == 20, "from v2");
+    check(loaded.size() == 3 && loaded[2].rank == 300, "current");
+    // Malformed data.
+    record r {};
+    check(!table.migrate(nsfx::type_name<record>::versioned_hash<1>(),
+                         "", 0, r), "malformed");
+    std::cout << nsfx::type_name<record>::versioned() << ": " << std::hex
+              << nsfx::type_name<record>::versioned_hash() << std::dec
+              << std::endl;
+
+    return failures;
+}
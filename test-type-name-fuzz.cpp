@@ -0,0 +1,222 @@
+/**
+ * @file
+ *
+ * @brief Type name extraction of random nested types.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "type-name.hpp"
+
+#include <cstdint>
+#include <typeinfo>
+#include <utility>
+
+namespace t {
+
+enum E {};
+class C {};
+struct S {};
+
+template<class T>
+struct box {};
+
+template<class A, class B>
+struct pair {};
+
+constexpr std::uint64_t next(std::uint64_t seed) noexcept
+{
+    return seed * 6364136223846793005ull + 1442695040888963407ull;
+}
+
+/**
+ * @brief A random object type.
+ *
+ * The leaves are builtin types, classes and enums.
+ * The nodes are cv-qualifiers, pointers, arrays, class templates,
+ * function pointers, member function pointers and member object pointers.
+ */
+template<std::uint64_t Seed, int Depth,
+         int Kind = static_cast<int>((Seed >> 33) % (Depth ? 13 : 5))>
+struct random_type;
+
+template<std::uint64_t Seed, int Depth>
+using random_t = typename random_type<next(Seed), Depth - 1>::type;
+
+template<std::uint64_t Seed, int Depth>
+using random2_t = typename random_type<next(next(Seed)), Depth - 1>::type;
+
+template<std::uint64_t Seed, int Depth>
+struct random_type<Seed, Depth, 0> { using type = int; };
+
+template<std::uint64_t Seed, int Depth>
+struct random_type<Seed, Depth, 1> { using type = C; };
+
+template<std::uint64_t Seed, int Depth>
+struct random_type<Seed, Depth, 2> { using type = E; };
+
+template<std::uint64_t Seed, int Depth>
+struct random_type<Seed, Depth, 3> { using type = S; };
+
+template<std::uint64_t Seed, int Depth>
+struct random_type<Seed, Depth, 4> { using type = unsigned char; };
+
+template<std::uint64_t Seed, int Depth>
+struct random_type<Seed, Depth, 5>
+{
+    using type = const random_t<Seed, Depth>;
+};
+
+template<std::uint64_t Seed, int Depth>
+struct random_type<Seed, Depth, 6>
+{
+    using type = volatile random_t<Seed, Depth>*;
+};
+
+template<std::uint64_t Seed, int Depth>
+struct random_type<Seed, Depth, 7>
+{
+    using type = random_t<Seed, Depth>*;
+};
+
+template<std::uint64_t Seed, int Depth>
+struct random_type<Seed, Depth, 8>
+{
+    using type = random_t<Seed, Depth>[2];
+};
+
+template<std::uint64_t Seed, int Depth>
+struct random_type<Seed, Depth, 9>
+{
+    using type = box<random_t<Seed, Depth>>;
+};
+
+template<std::uint64_t Seed, int Depth>
+struct random_type<Seed, Depth, 10>
+{
+    using type = pair<random_t<Seed, Depth>, random2_t<Seed, Depth>>;
+};
+
+template<std::uint64_t Seed, int Depth>
+struct random_type<Seed, Depth, 11>
+{
+    using type = random_t<Seed, Depth>* (*)(random2_t<Seed, Depth>&);
+};
+
+template<std::uint64_t Seed, int Depth>
+struct random_type<Seed, Depth, 12>
+{
+    using type = random_t<Seed, Depth>* (C::*)(random2_t<Seed, Depth>) const;
+};
+
+/**
+ * @brief The properties of a type name.
+ */
+struct entry
+{
+    std::string_view name_;
+    std::uint64_t hash_;
+    const std::type_info* info_;
+};
+
+template<class T>
+constexpr bool balanced(void) noexcept
+{
+    constexpr std::string_view name = nsfx::type_name_v<T>.view();
+    int depth = 0;
+    for (const char c : name)
+    {
+        if (c == '<' || c == '(' || c == '[')
+        {
+            ++depth;
+        }
+        else if (c == '>' || c == ')' || c == ']')
+        {
+            if (--depth < 0)
+            {
+                return false;
+            }
+        }
+    }
+    return depth == 0 && !name.empty() &&
+           name.front() != ' ' && name.back() != ' ';
+}
+
+/**
+ * @brief Check the name of a type.
+ *
+ * @return The number of failures.
+ */
+template<class T>
+int check(entry& e)
+{
+    int failures = 0;
+    auto fail = [&](const char* what) {
+        std::cout << "FAILED: " << what << ": "
+                  << nsfx::type_name<T>::name() << std::endl;
+        ++failures;
+    };
+    // The name is complete.
+    static_assert(balanced<T>());
+    // The name within another name is the same.
+    static_assert(nsfx::template_args<box<T>>()[0] ==
+                  nsfx::type_name_v<T>.view());
+    // The encoded identifier is reversible.
+    static_assert(nsfx::decode_identifier(
+                      nsfx::type_name<T>::encoded_identifier()).view() ==
+                  nsfx::type_name_v<T>.view());
+#if defined(__GNUC__)
+    // The mangled name agrees with the compiler.
+    if (nsfx::type_name<box<T>>::mangled().view() != typeid (box<T>).name())
+    {
+        fail("mangled");
+    }
+#endif // defined(__GNUC__)
+    e = entry{nsfx::type_name_v<T>.view(), nsfx::type_name<T>::hash(),
+              &typeid (box<T>)};
+    return failures;
+}
+
+template<std::size_t... Is>
+int fuzz(std::index_sequence<Is...>)
+{
+    constexpr std::size_t N = sizeof... (Is);
+    entry entries[N] {};
+    int failures = 0;
+    ((failures += check<typename random_type<
+        next(Is * 0x9e3779b97f4a7c15ull), 4>::type>(entries[Is])), ...);
+    // The names identify the types.
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        for (std::size_t j = i + 1; j < N; ++j)
+        {
+            const bool same = *entries[i].info_ == *entries[j].info_;
+            if (same != (entries[i].name_ == entries[j].name_) ||
+                same != (entries[i].hash_ == entries[j].hash_))
+            {
+                std::cout << "FAILED: " << entries[i].name_ << " vs "
+                          << entries[j].name_ << std::endl;
+                ++failures;
+            }
+        }
+    }
+    for (std::size_t i = 0; i < N; i += 16)
+    {
+        std::cout << entries[i].name_ << std::endl;
+    }
+    return failures;
+}
+
+} // namespace t
+
+
+int main(void)
+{
+    return t::fuzz(std::make_index_sequence<128>{});
+}
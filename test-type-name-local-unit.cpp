@@ -0,0 +1,45 @@
+/**
+ * @file
+ *
+ * @brief Another translation unit of test-type-name-local.cpp.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#if !defined(NSFX_TYPE_NAME_LOCAL_SCOPE)
+# define NSFX_TYPE_NAME_LOCAL_SCOPE  2
+#endif
+
+#include "type-name.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+namespace t {
+
+struct shared {};
+
+namespace {
+
+struct A {};
+
+} // unnamed namespace
+
+} // namespace t
+
+
+std::string_view unit_name_of_a(void)
+{
+    return nsfx::type_name_v<t::A>.view();
+}
+
+std::uint64_t unit_hash_of_shared(void)
+{
+    return nsfx::type_name<t::shared>::hash();
+}
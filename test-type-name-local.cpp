@@ -0,0 +1,142 @@
+/**
+ * @file
+ *
+ * @brief Names of the types that are local to translation units.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+// Name anonymous namespaces by the file name, and shorten local scopes.
+// It is also built with `1`.
+#if !defined(NSFX_TYPE_NAME_LOCAL_SCOPE)
+# define NSFX_TYPE_NAME_LOCAL_SCOPE  2
+#endif
+
+#include "type-name.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string_view>
+#include <type_traits>
+
+namespace t {
+
+template<class T>
+struct vector {};
+
+struct shared {};
+
+template<class T>
+auto local(T, const std::map<int, T>&) noexcept
+{
+    struct X {};
+    return X{};
+}
+
+// Overloads that differ only in their parameters.
+inline auto overload(int) noexcept
+{
+    struct X {};
+    return X{};
+}
+
+inline auto overload(double) noexcept
+{
+    struct X {};
+    return X{};
+}
+
+namespace {
+
+struct A {};
+
+} // unnamed namespace
+
+// Not in an anonymous namespace, but has the same name as `A` in mode `1`.
+struct anon {};
+
+} // namespace t
+
+// Defined in test-type-name-local-unit.cpp.
+std::string_view unit_name_of_a(void);
+std::uint64_t unit_hash_of_shared(void);
+
+
+int main(void)
+{
+    int failures = 0;
+    using normalize_transform =
+        nsfx::details::type_name::normalize_transform<
+            nsfx::details::type_name::shared_unit>;
+    constexpr auto normalize = [] (auto str) {
+        nsfx::fixed_string_t<64> dst {};
+        nsfx::details::type_name::transform_to<normalize_transform>(
+            str, dst);
+        return dst;
+    };
+    static_assert(normalize(nsfx::to_fixed_string(
+        "ns::(anonymous namespace)::X")).view() == "ns::{anon}::X");
+    static_assert(normalize(nsfx::to_fixed_string(
+        "`anonymous namespace'::X")).view() == "{anon}::X");
+    static_assert(normalize(nsfx::to_fixed_string(
+        "ns::f<int>(int, std::vector<int>) const &&::X")).view() ==
+        "ns::f<int>()::X");
+    static_assert(normalize(nsfx::to_fixed_string(
+        "ns::E(ns::C, ns::S)")).view() == "ns::E(ns::C, ns::S)");
+    static_assert(normalize(nsfx::to_fixed_string(
+        "`int ns::f<int>(int,std::vector<int>)'::`2'::X")).view() ==
+        "ns::f<int>()::X");
+
+    using X = decltype(t::local(1, std::map<int, int>{}));
+    static_assert(nsfx::type_name_v<X>.view() == "t::local<int>()::X");
+    static_assert(nsfx::type_name_v<t::vector<X>>.view() ==
+                  "t::vector<t::local<int>()::X>");
+    // The local classes of overloads collide, since the parameters are
+    // removed.
+    using XI = decltype(t::overload(1));
+    using XD = decltype(t::overload(1.0));
+    static_assert(!std::is_same_v<XI, XD>);
+    static_assert(nsfx::type_name_v<XI>.view() == "t::overload()::X");
+    static_assert(nsfx::type_name_v<XD>.view() == "t::overload()::X");
+    static_assert(nsfx::type_name<XI>::hash() == nsfx::type_name<XD>::hash());
+
+#if NSFX_TYPE_NAME_LOCAL_SCOPE == 2
+    static_assert(nsfx::type_name_v<t::A>.view() ==
+                  "t::{test-type-name-local.cpp}::A");
+    static_assert(nsfx::type_name_v<t::vector<t::A>>.view() ==
+                  "t::vector<t::{test-type-name-local.cpp}::A>");
+    // The types in anonymous namespaces of different translation units are
+    // named apart.
+    if (unit_name_of_a() != "t::{test-type-name-local-unit.cpp}::A")
+    {
+        std::cout << "FAILED: " << unit_name_of_a() << std::endl;
+        ++failures;
+    }
+#else
+    static_assert(nsfx::type_name_v<t::A>.view() == "t::{anon}::A");
+    if (unit_name_of_a() != "t::{anon}::A")
+    {
+        std::cout << "FAILED: " << unit_name_of_a() << std::endl;
+        ++failures;
+    }
+#endif
+    // An anonymous namespace is never dropped.
+    static_assert(nsfx::type_name<t::A>::hash() !=
+                  nsfx::type_name<t::anon>::hash());
+    // The shared types are named alike in all translation units.
+    if (unit_hash_of_shared() != nsfx::type_name<t::shared>::hash())
+    {
+        std::cout << "FAILED: shared" << std::endl;
+        ++failures;
+    }
+    std::cout << nsfx::type_name_v<t::A> << std::endl;
+    std::cout << unit_name_of_a() << std::endl;
+
+    return failures;
+}
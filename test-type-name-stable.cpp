@@ -0,0 +1,71 @@
+/**
+ * @file
+ *
+ * @brief Stable names of closure types.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+// Name closure types stably.
+#define NSFX_TYPE_NAME_STABLE_LAMBDA  1
+
+#include "type-name.hpp"
+
+namespace t {
+
+template<class T>
+struct vector {};
+
+struct on_add {};
+
+} // namespace t
+
+
+int main(void)
+{
+    int failures = 0;
+    using normalize_transform =
+        nsfx::details::type_name::normalize_transform<
+            nsfx::details::type_name::shared_unit>;
+    constexpr auto normalize = [] (auto str) {
+        nsfx::fixed_string_t<64> dst {};
+        nsfx::details::type_name::transform_to<normalize_transform>(
+            str, dst);
+        return dst;
+    };
+    static_assert(normalize(nsfx::to_fixed_string(
+        "t::vector<(lambda at /src/a.cpp:12:5)>")).view() ==
+        "t::vector<<lambda>>");
+    static_assert(normalize(nsfx::to_fixed_string(
+        "(unnamed struct at C:\\src (x86)\\a.cpp:3:1)*")).view() ==
+        "<unnamed struct>*");
+    static_assert(normalize(nsfx::to_fixed_string(
+        "t::vector<<lambda_8f3e0c1b2a4d5e6f>>")).view() ==
+        "t::vector<<lambda>>");
+    static_assert(normalize(nsfx::to_fixed_string(
+        "main::<lambda_1>")).view() == "main::<lambda_1>");
+    // The local scopes are kept.
+    static_assert(normalize(nsfx::to_fixed_string(
+        "ns::(anonymous namespace)::X")).view() ==
+        "ns::(anonymous namespace)::X");
+
+    auto f = [] (int a) { return a; };
+    std::cout << nsfx::type_name<t::vector<decltype(f)>>::name() << std::endl;
+    // A tagged closure is named by its tag in every mode.
+    auto add = nsfx::make_tagged<t::on_add>(f);
+    static_assert(nsfx::type_name_v<decltype(add)>.view() ==
+                  "nsfx::tagged<t::on_add>");
+    if (add(3) != 3)
+    {
+        std::cout << "FAILED: tagged" << std::endl;
+        ++failures;
+    }
+
+    return failures;
+}
@@ -14,14 +14,34 @@
 
 #include "type-name.hpp"
 
+#include <map>
+#include <string>
+#include <typeinfo>
+
 namespace t {
 
 enum E {};
 enum class EC {};
+enum class opcode { add, sub };
 enum struct ES {};
 class C {};
 struct S {};
 
+template<class T>
+struct vector {};
+
+template<int N>
+struct num {};
+
+struct outer
+{
+    struct inner {};
+};
+
+int failures = 0;
+
+int reg = 0;
+
 template<class T>
 void show(void)
 {
@@ -31,10 +51,80 @@ void show(void)
     std::cout << "  N:  " << name << std::endl;
     constexpr auto base = nsfx::type_name<T>::base();
     std::cout << "  B:  " << base << std::endl;
+    constexpr auto id = nsfx::type_name<T>::identifier();
+    std::cout << "  I:  " << id << std::endl;
+    constexpr auto enc = nsfx::type_name<T>::encoded_identifier();
+    std::cout << "  X:  " << enc << std::endl;
+    static_assert(nsfx::decode_identifier(enc).view() == name.view());
+    // Wrap the type, since typeid() drops top-level cv and references.
+    constexpr auto mangled = nsfx::type_name<vector<T>>::mangled();
+    std::cout << "  M:  " << mangled << std::endl;
+#if defined(__GNUC__)
+    if (mangled.view() != typeid (vector<T>).name())
+    {
+        std::cout << "  FAILED: " << typeid (vector<T>).name() << std::endl;
+        ++failures;
+    }
+#endif // defined(__GNUC__)
+}
+
+template<class T>
+auto local(T, const std::map<int, T>&) noexcept
+{
+    struct X {};
+    return X{};
+}
+
+struct ping {};
+struct pong {};
+struct pong2 {};
+
+struct on_add;
+struct on_sub;
+struct on_mul;
+
+int subtract(int a, int b)
+{
+    return a - b;
 }
 
+struct twice final
+{
+    int operator()(int a) const noexcept
+    {
+        return 2 * a;
+    }
+};
+
 } // namespace t
 
+template<>
+struct nsfx::type_name_override<t::ping>
+{
+    static constexpr std::string_view name = "proto.Ping";
+};
+
+template<>
+struct nsfx::type_name_override<t::pong>
+{
+    static constexpr std::string_view name = "proto::Pong";
+    static constexpr std::uint64_t hash = 0x504f4e47;
+};
+
+// The same explicit name as `t::pong`, but another explicit hash.
+template<>
+struct nsfx::type_name_override<t::pong2>
+{
+    static constexpr std::string_view name = "proto::Pong";
+    static constexpr std::uint64_t hash = 0x504f4e48;
+};
+
+namespace {
+
+struct A {};
+
+} // unnamed namespace
+
 
 int main(void)
 {
@@ -116,6 +206,149 @@ int main(void)
     show<E(C::*)>();
     show<E(C::*&)(S)>();
     show<E(C::*&)>();
+    ////////////////////
+    // encoding
+    ////////////////////
+    static_assert(nsfx::type_name<C>::u8name().view() == u8"t::C");
+    static_assert(nsfx::type_name<C>::wname().view() == L"t::C");
+    static_assert(nsfx::type_name<C>::u16name().view() == u"t::C");
+    static_assert(nsfx::type_name<const S&>::u16name().view() == u"const t::S&");
+    {
+        constexpr auto s = nsfx::to_fixed_string("t::\xc3\xa9\xf0\x9f\x98\x80");
+        constexpr std::size_t L =
+            nsfx::details::type_name::transcoded_size<char16_t>(s);
+        static_assert(L == 6);
+        constexpr auto u16 = [&] {
+            nsfx::basic_fixed_string<char16_t, L+1> dst {};
+            nsfx::details::type_name::transcode(s, dst);
+            return dst;
+        }();
+        static_assert(u16.view() == u"t::\u00e9\U0001F600");
+    }
+
+    ////////////////////
+    // identifier
+    ////////////////////
+    static_assert(nsfx::type_name<vector<int>>::identifier().view() ==
+                  "t__vector_lt_int_gt");
+    static_assert(nsfx::type_name<vector<int>>::encoded_identifier().view() ==
+                  "t_nvector_lint_g");
+    static_assert(nsfx::type_name<const C*>::identifier().view() ==
+                  "const_t__C_ptr");
+    static_assert(nsfx::decode_identifier(
+                      nsfx::to_fixed_string("a__b_x7ec_z")).view() == "a_b~c?");
+    show<vector<const C*>>();
+
+    ////////////////////
+    // mangled
+    ////////////////////
+    static_assert(nsfx::type_name<const C*>::mangled().view() == "PKN1t1CE");
+    show<void(C::*)(void (C::*)(void) const)>();
+    show<const C* const*>();
+    show<E*[2][3]>();
+    show<int(*)(int, ...)>();
+    show<outer::inner>();
+    show<num<-3>>();
+    show<vector<vector<int>>>();
+    show<std::nullptr_t>();
+    show<std::allocator<int>>();
+    show<std::string>();
+    show<std::wstring>();
+    show<std::ostream>();
+    show<std::map<int, C>>();
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 u128;
+    show<u128>();
+#endif
+
+    ////////////////////
+    // template arguments
+    ////////////////////
+    static_assert(nsfx::template_args<C>().size() == 0);
+    static_assert(nsfx::template_args<vector<int>>().size() == 1);
+    static_assert(nsfx::template_args<vector<int>>()[0] == "int");
+    static_assert(nsfx::template_args<num<-3>>()[0] == "-3");
+    static_assert(nsfx::template_args<vector<const C*>>()[0] == "const t::C*");
+    static_assert(nsfx::template_args<vector<E(C, S)>>()[0] == "t::E(t::C, t::S)");
+    static_assert(nsfx::template_args<vector<vector<C>>>()[0] ==
+                  nsfx::type_name_v<vector<C>>.view());
+    static_assert(nsfx::template_args<std::map<int, C>>()[0] == "int");
+    static_assert(nsfx::template_args<std::map<int, C>>()[1] == "t::C");
+    static_assert(nsfx::type_base_v<vector<const C*>>.view() ==
+                  "vector<const t::C*>");
+    static_assert(nsfx::type_base_v<std::map<int, C>>.view() ==
+                  "map<int, t::C>");
+    static_assert(nsfx::type_base_v<outer::inner>.view() == "inner");
+
+    ////////////////////
+    // value names
+    ////////////////////
+    static_assert(nsfx::value_name<-3>().view() == "-3");
+    static_assert(nsfx::value_name<42u>().view() == "42");
+    static_assert(nsfx::value_name<true>().view() == "true");
+    static_assert(nsfx::value_name_v<opcode::sub>.view() == "t::opcode::sub");
+    static_assert(nsfx::value_name_v<&reg>.view() == "&t::reg");
+    std::cout << nsfx::value_name<static_cast<opcode>(7)>() << std::endl;
+    std::cout << nsfx::value_name<nullptr>() << std::endl;
+
+    ////////////////////
+    // closures
+    ////////////////////
+    {
+        auto add = nsfx::make_tagged<on_add>([] (int a, int b) { return a + b; });
+        auto sub = nsfx::make_tagged<on_sub>(&subtract);
+        static_assert(nsfx::type_name_v<decltype(add)>.view() ==
+                      "nsfx::tagged<t::on_add>");
+        static_assert(nsfx::type_name_v<decltype(sub)>.view() ==
+                      "nsfx::tagged<t::on_sub>");
+        std::cout << nsfx::type_name<decltype(add)>::name() << std::endl;
+        std::cout << nsfx::type_name<decltype(sub)>::name() << std::endl;
+        auto mul = nsfx::make_tagged<on_mul>(twice{});
+        if (add(3, 2) != 5 || sub(3, 2) != 1 || mul(3) != 6 ||
+            nsfx::type_name<decltype(add)>::hash() ==
+            nsfx::type_name<decltype(sub)>::hash() ||
+            !nsfx::details::type_name::tag_claimed<on_mul, twice>)
+        {
+            std::cout << "FAILED: tagged" << std::endl;
+            ++failures;
+        }
+#if defined(TYPE_NAME_EXPECT_TAG_CLASH)
+        // The tag has been claimed by the closure of `add`.
+        auto twice_add = nsfx::make_tagged<on_add>(twice{});
+        (void)twice_add;
+#endif // defined(TYPE_NAME_EXPECT_TAG_CLASH)
+    }
+
+    ////////////////////
+    // local scopes
+    ////////////////////
+    show<A>();
+    // The mangled names of local classes are not supported.
+    using X = decltype(local(1, std::map<int, int>{}));
+    std::cout << nsfx::type_name_v<X> << std::endl;
+
+    ////////////////////
+    // explicit names
+    ////////////////////
+    static_assert(nsfx::type_name_v<ping>.view() == "proto.Ping");
+    static_assert(nsfx::type_base_v<ping>.view() == "proto.Ping");
+    static_assert(nsfx::type_name<ping>::hash() ==
+                  nsfx::details::type_name::fnv1a("proto.Ping"));
+    static_assert(nsfx::type_name<ping>::identifier().view() ==
+                  "proto_dot_Ping");
+    static_assert(nsfx::type_name_v<pong>.view() == "proto::Pong");
+    static_assert(nsfx::type_base_v<pong>.view() == "Pong");
+    static_assert(nsfx::type_name<pong>::hash() == 0x504f4e47);
+    // The explicit hash is continued by the version.
+    static_assert(nsfx::type_name<pong>::versioned_hash<2>() ==
+                  nsfx::details::type_name::fnv1a("@2", 0x504f4e47));
+    static_assert(nsfx::type_name<pong>::versioned_hash<2>() !=
+                  nsfx::type_name<pong2>::versioned_hash<2>());
+    static_assert(nsfx::type_name<ping>::versioned_hash<2>() ==
+                  nsfx::details::type_name::fnv1a("proto.Ping@2"));
+    // The compound types are spelled by the compiler.
+    static_assert(nsfx::type_name_v<const ping*>.view() == "const t::ping*");
+    show<ping>();
 
-    return 0;
+    return failures;
 }
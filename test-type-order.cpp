@@ -0,0 +1,76 @@
+/**
+ * @file
+ *
+ * @brief Type ordering at compile time.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "type-order.hpp"
+
+namespace t {
+
+struct A {};
+struct B {};
+struct C {};
+
+template<class List>
+struct show;
+
+template<class... Ts>
+struct show<nsfx::type_list<Ts...>>
+{
+    static void print(void)
+    {
+        ((std::cout << nsfx::type_name<Ts>::name() << " "), ...);
+        std::cout << std::endl;
+    }
+};
+
+} // namespace t
+
+
+int main(void)
+{
+    using namespace t;
+    using nsfx::type_list;
+    using nsfx::type_sort_t;
+    ////////////////////
+    // type_less
+    ////////////////////
+    static_assert( nsfx::type_less_v<A, B>);
+    static_assert(!nsfx::type_less_v<B, A>);
+    static_assert(!nsfx::type_less_v<A, A>);
+    static_assert( nsfx::type_less_v<int, long>);
+    static_assert(nsfx::type_compare<C, C>() == 0);
+    ////////////////////
+    // type_sort
+    ////////////////////
+    static_assert(std::is_same_v<type_sort_t<type_list<>>, type_list<>>);
+    static_assert(std::is_same_v<type_sort_t<type_list<C>>, type_list<C>>);
+    static_assert(std::is_same_v<type_sort_t<type_list<C, A, B>>,
+                                 type_list<A, B, C>>);
+    static_assert(std::is_same_v<type_sort_t<type_list<B, C, A>>,
+                                 type_list<A, B, C>>);
+    // Stable for equivalent types.
+    static_assert(std::is_same_v<type_sort_t<type_list<B, A, B>>,
+                                 type_list<A, B, B>>);
+    ////////////////////
+    // sorted_tuple_t
+    ////////////////////
+    static_assert(std::is_same_v<nsfx::sorted_tuple_t<double, C, int, A>,
+                                 nsfx::sorted_tuple_t<A, int, C, double>>);
+    ////////////////////
+    // type_position
+    ////////////////////
+    static_assert(nsfx::type_position_v<C, type_list<A, B, C>> == 2);
+    show<type_sort_t<type_list<double, C, int, B, A, char>>>::print();
+
+    return 0;
+}
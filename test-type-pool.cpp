@@ -0,0 +1,216 @@
+/**
+ * @file
+ *
+ * @brief Per-type object pools with thread-local free lists.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "type-pool.hpp"
+
+#include <string>
+#include <thread>
+
+namespace t {
+
+struct small
+{
+    char c;
+};
+
+struct message
+{
+    static inline int alive = 0;
+    std::uint64_t seq;
+    std::string text;
+
+    message(std::uint64_t s, std::string t)
+        : seq(s), text(std::move(t))
+    {
+        ++alive;
+    }
+
+    ~message(void)
+    {
+        --alive;
+    }
+};
+
+struct alignas(64) line
+{
+    std::uint64_t words[3];
+};
+
+struct throwing
+{
+    throwing(void)
+    {
+        throw 1;
+    }
+};
+
+} // namespace t
+
+namespace nsfx {
+
+// Tiny slabs, so that several slabs are carved.
+template<>
+struct type_pool_traits<t::small>
+{
+    static constexpr std::size_t slab_size = 256;
+    static constexpr std::size_t batch = 4;
+};
+
+} // namespace nsfx
+
+
+int main(void)
+{
+    using namespace t;
+    int failures = 0;
+    auto check = [&] (bool ok, const char* what) {
+        if (!ok)
+        {
+            std::cout << "FAILED: " << what << std::endl;
+            ++failures;
+        }
+    };
+    ////////////////////
+    // size classes
+    ////////////////////
+    using nsfx::details::type_pool::pool;
+    static_assert(pool<small>::size == sizeof (void*));
+    static_assert(pool<message>::size == sizeof (message));
+    static_assert(pool<line>::size == 64 && pool<line>::alignment == 64);
+    static_assert(pool<small>::per_slab == 256 / sizeof (void*));
+    ////////////////////
+    // create and destroy
+    ////////////////////
+    {
+        message* m = nsfx::type_pool<message>::create(1, "hello");
+        check(m->seq == 1 && m->text == "hello", "create");
+        check(message::alive == 1, "constructed");
+        nsfx::type_pool<message>::destroy(m);
+        check(message::alive == 0, "destroyed");
+        // The storage is reused.
+        message* n = nsfx::type_pool<message>::create(2, "world");
+        check(n == m, "reuse");
+        nsfx::type_pool<message>::destroy(n);
+        bool thrown = false;
+        try
+        {
+            nsfx::type_pool<throwing>::create();
+        }
+        catch (int)
+        {
+            thrown = true;
+        }
+        check(thrown, "throw");
+        check(nsfx::type_pool<throwing>::stats().live_ == 0, "throw: freed");
+    }
+    ////////////////////
+    // alignment
+    ////////////////////
+    {
+        std::vector<line*> lines;
+        for (int i = 0; i < 100; ++i)
+        {
+            lines.push_back(nsfx::type_pool<line>::create());
+        }
+        bool aligned = true;
+        for (line* l : lines)
+        {
+            aligned = aligned && reinterpret_cast<std::uintptr_t>(l) % 64 == 0;
+            nsfx::type_pool<line>::destroy(l);
+        }
+        check(aligned, "alignment");
+    }
+    ////////////////////
+    // stats
+    ////////////////////
+    {
+        std::vector<void*> p;
+        for (int i = 0; i < 1000; ++i)
+        {
+            p.push_back(nsfx::type_pool<small>::allocate());
+        }
+        auto s = nsfx::type_pool<small>::stats();
+        check(s.name_ == "t::small", "name");
+        check(s.base_ == "small", "base");
+        check(s.hash_ == nsfx::type_name<small>::hash(), "hash");
+        check(s.live_ == 1000, "live");
+        check(s.allocations_ == 1000, "allocations");
+        check(s.slabs_ == (1000 + 31) / 32, "slabs");
+        check(s.capacity_ == s.slabs_ * 32, "capacity");
+        for (void* q : p)
+        {
+            nsfx::type_pool<small>::deallocate(q);
+        }
+        check(nsfx::type_pool<small>::stats().live_ == 0, "live after free");
+    }
+    ////////////////////
+    // threads
+    ////////////////////
+    {
+        constexpr int num_threads = 4;
+        constexpr int num_objects = 10000;
+        // Allocated by a thread, and deallocated by another thread.
+        std::vector<std::vector<void*>> p(num_threads);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < num_threads; ++i)
+        {
+            threads.emplace_back([&p, i] {
+                for (int k = 0; k < num_objects; ++k)
+                {
+                    void* q = nsfx::type_pool<small>::allocate();
+                    static_cast<small*>(q)->c = static_cast<char>(i);
+                    p[i].push_back(q);
+                }
+            });
+        }
+        for (auto& th : threads)
+        {
+            th.join();
+        }
+        threads.clear();
+        check(nsfx::type_pool<small>::stats().live_ ==
+              num_threads * num_objects, "threads: live");
+        for (int i = 0; i < num_threads; ++i)
+        {
+            threads.emplace_back([&p, i] {
+                for (void* q : p[(i + 1) % num_threads])
+                {
+                    nsfx::type_pool<small>::deallocate(q);
+                }
+            });
+        }
+        for (auto& th : threads)
+        {
+            th.join();
+        }
+        auto s = nsfx::type_pool<small>::stats();
+        check(s.live_ == 0, "threads: live after free");
+        check(s.allocations_ == 1000 + num_threads * num_objects,
+              "threads: allocations");
+    }
+    ////////////////////
+    // snapshot
+    ////////////////////
+    std::size_t found = 0;
+    for (const auto& s : nsfx::type_pools::snapshot())
+    {
+        std::cout << s.name_ << ": " << s.live_ << " live, " << s.slabs_
+                  << " slabs of " << s.object_size_ << "-byte objects"
+                  << std::endl;
+        found += s.name_ == "t::small" || s.name_ == "t::message";
+    }
+    check(found == 2, "snapshot");
+
+    return failures;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file
+ *
+ * @brief Binary framing of messages tagged by type hashes.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#include "typed-frame.hpp"
+
+#include <string>
+#include <string_view>
+
+namespace t {
+
+struct ping
+{
+    std::uint32_t seq;
+};
+
+struct pong
+{
+    std::uint32_t seq;
+    std::uint32_t delay;
+};
+
+// A message with a variable-length payload.
+struct chat {};
+
+struct counts
+{
+    int pings = 0;
+    int pongs = 0;
+    std::string text;
+};
+
+} // namespace t
+
+
+int main(void)
+{
+    using namespace t;
+    int failures = 0;
+    auto check = [&] (bool ok, const char* what) {
+        if (!ok)
+        {
+            std::cout << "FAILED: " << what << std::endl;
+            ++failures;
+        }
+    };
+    ////////////////////
+    // header
+    ////////////////////
+    static_assert(nsfx::typed_frame<ping>::type_hash ==
+                  nsfx::type_name<ping>::hash());
+    static_assert(nsfx::typed_frame<ping>::header(4).payload_len_ == 4);
+    unsigned char h[nsfx::frame_header::size];
+    nsfx::write_frame_header(h, nsfx::frame_header{0x0102030405060708ull, 9});
+    check(h[0] == 0x08 && h[7] == 0x01 && h[8] == 9, "little-endian");
+    check(nsfx::read_frame_header(h).type_hash_ == 0x0102030405060708ull,
+          "read header");
+    ////////////////////
+    // frames
+    ////////////////////
+    std::vector<unsigned char> buf;
+    nsfx::typed_frame<ping>::append(buf, ping{1});
+    nsfx::typed_frame<pong>::append(buf, pong{1, 30});
+    const std::string_view hello = "hello";
+    nsfx::typed_frame<chat>::append(buf, hello.data(), hello.size());
+    // Padding.
+    const unsigned char zeros[3] {};
+    const std::size_t pos = buf.size();
+    buf.resize(pos + nsfx::frame_header::size + sizeof (zeros));
+    nsfx::write_frame_header(buf.data() + pos,
+                             nsfx::frame_header{nsfx::padding_frame_hash,
+                                                sizeof (zeros)});
+    // A frame of an unknown type.
+    nsfx::typed_frame<int>::append(buf, 42);
+    nsfx::typed_frame<ping>::append(buf, ping{2});
+    check(buf.size() == 6 * nsfx::frame_header::size + 4 + 8 + 5 + 3 + 4 + 4,
+          "frame sizes");
+    // An incomplete frame.
+    const std::size_t complete = buf.size();
+    nsfx::typed_frame<pong>::append(buf, pong{2, 40});
+    buf.resize(buf.size() - 1);
+    ////////////////////
+    // dispatch
+    ////////////////////
+    counts c;
+    nsfx::frame_dispatcher d;
+    d.on<ping>([] (void* ctx, const nsfx::frame_view& f) {
+        ping p;
+        if (f.load(p))
+        {
+            ++static_cast<counts*>(ctx)->pings;
+        }
+    }, &c);
+    d.on<pong>([] (void* ctx, const nsfx::frame_view& f) {
+        pong p;
+        if (f.load(p) && p.delay == 30)
+        {
+            ++static_cast<counts*>(ctx)->pongs;
+        }
+    }, &c);
+    d.on<chat>([] (void* ctx, const nsfx::frame_view& f) {
+        // The payload is not copied.
+        static_cast<counts*>(ctx)->text.assign(
+            reinterpret_cast<const char*>(f.payload_), f.payload_len_);
+    }, &c);
+    nsfx::frame_reader r(buf.data(), buf.size());
+    const std::size_t unknown = d.dispatch_all(r);
+    check(unknown == 1, "unknown");
+    check(c.pings == 2, "pings");
+    check(c.pongs == 1, "pongs");
+    check(c.text == "hello", "chat");
+    check(r.consumed() == complete, "incomplete");
+    nsfx::frame_view f;
+    check(!r.peek(f), "peek incomplete");
+    ////////////////////
+    // hash table
+    ////////////////////
+    for (std::uint64_t i = 1; i <= 100; ++i)
+    {
+        d.on(i * 0x9e3779b97f4a7c15ull, nullptr, nullptr);
+    }
+    check(d.size() == 103, "size");
+    d.on<ping>([] (void* ctx, const nsfx::frame_view&) {
+        static_cast<counts*>(ctx)->pings = -1;
+    }, &c);
+    check(d.size() == 103, "replace");
+    check(!d.on(nsfx::padding_frame_hash, nullptr, nullptr) &&
+          d.size() == 103, "reserved hash");
+    nsfx::frame_reader r2(buf.data(), buf.size());
+    check(d.dispatch_all(r2) == 1 && c.pings == -1 && c.pongs == 2,
+          "dispatch after growth");
+    std::cout << "frames: " << complete << " bytes" << std::endl;
+
+    return failures;
+}
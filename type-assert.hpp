@@ -0,0 +1,142 @@
+/**
+ * @file
+ *
+ * @brief Static assertions with type names in the diagnostics.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#ifndef TYPE_ASSERT_HPP__1C5E7A93_B24D_4F06_8D3A_6E9F0B2C4D17
+#define TYPE_ASSERT_HPP__1C5E7A93_B24D_4F06_8D3A_6E9F0B2C4D17
+
+#include "type-name.hpp"
+
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+
+namespace nsfx {
+
+/**
+ * @brief Get the position of the first differing character of two strings.
+ *
+ * @return
+ *   The position of the first differing character.\n
+ *   If one string is the prefix of the other, the length of the shorter one
+ *   is returned.\n
+ *   If the strings are the same, `std::string_view::npos` is returned.
+ */
+constexpr std::size_t first_difference(std::string_view a,
+                                       std::string_view b) noexcept
+{
+    std::size_t pos = 0;
+    while (pos < a.size() && pos < b.size() && a[pos] == b[pos])
+    {
+        ++pos;
+    }
+    if (pos == a.size() && pos == b.size())
+    {
+        pos = std::string_view::npos;
+    }
+    return pos;
+}
+
+namespace details {
+namespace type_assert {
+
+/**
+ * @brief A string carried by a template.
+ *
+ * The compilers print the characters in the diagnostics.
+ */
+template<char... Cs>
+struct chars {};
+
+template<const auto& S, class Indices>
+struct to_chars;
+
+template<const auto& S, std::size_t... Is>
+struct to_chars<S, std::index_sequence<Is...>>
+{
+    using type = chars<S[Is]...>;
+};
+
+/**
+ * @brief The name of a type carried by a template.
+ */
+template<class T>
+using name_chars = typename to_chars<
+    type_name_v<T>,
+    std::make_index_sequence<type_name_v<T>.size_>>::type;
+
+template<class... Ts>
+inline constexpr bool always_false = false;
+
+/**
+ * @brief The diagnostic of `static_assert_same<A, B>()`.
+ *
+ * It is only instantiated when the types are not the same.
+ * The compilers print its template arguments in the diagnostic:
+ * the types, their names, and the position of the first differing character.
+ * If the position is `npos`, the types have the same name.
+ */
+template<class A, class B, class NameA, class NameB, std::size_t DiffPos>
+struct types_differ
+{
+    static_assert(always_false<A, B>,
+                  "The types are not the same. "
+                  "See the template arguments of types_differ<> for the "
+                  "type names and the position of the first difference.");
+    static constexpr bool value = false;
+};
+
+} // namespace type_assert
+} // namespace details
+
+
+/**
+ * @brief Assert that two types are the same at compile time.
+ *
+ * On failure, the diagnostic shows `type_name<A>::name()`,
+ * `type_name<B>::name()`, and the position of the first differing character.
+ *
+ * It costs nothing when the assertion holds: the diagnostic is never
+ * instantiated.
+ *
+ * @code
+ * static_assert(nsfx::static_assert_same<A, B>());
+ * @endcode
+ *
+ * @return `true` if the types are the same.
+ *         Otherwise, the program is ill-formed.
+ */
+template<class A, class B>
+constexpr bool static_assert_same(void) noexcept
+{
+    if constexpr (std::is_same_v<A, B>)
+    {
+        return true;
+    }
+    else
+    {
+        return details::type_assert::types_differ<
+            A, B,
+            details::type_assert::name_chars<A>,
+            details::type_assert::name_chars<B>,
+            first_difference(type_name_v<A>.view(),
+                             type_name_v<B>.view())>::value;
+    }
+}
+
+} // namespace nsfx
+
+
+#endif // TYPE_ASSERT_HPP__1C5E7A93_B24D_4F06_8D3A_6E9F0B2C4D17
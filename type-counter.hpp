@@ -0,0 +1,646 @@
+/**
+ * @file
+ *
+ * @brief Per-type counters and histograms with lock-free increments.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#ifndef TYPE_COUNTER_HPP__A93E1F57_2C4B_4D8E_B0A6_7C5F3D1E9B28
+#define TYPE_COUNTER_HPP__A93E1F57_2C4B_4D8E_B0A6_7C5F3D1E9B28
+
+#include "type-id.hpp"
+#include "type-escape.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <string_view>
+#include <vector>
+
+
+namespace nsfx {
+
+/**
+ * @brief The traits of a counter domain.
+ *
+ * Specialize it to change the capacity of a domain.
+ *
+ * @tparam Tag The tag of the domain.
+ */
+template<class Tag>
+struct type_counter_traits
+{
+    /**
+     * @brief The maximum number of types counted within the domain.
+     */
+    static constexpr std::size_t capacity = 256;
+};
+
+/**
+ * @brief The traits of a histogram domain.
+ *
+ * Specialize it to change the buckets of a domain.
+ *
+ * @tparam Tag The tag of the domain.
+ */
+template<class Tag>
+struct type_histogram_traits
+{
+    /**
+     * @brief The inclusive upper bounds of the buckets in ascending order.
+     *
+     * The last bucket `+Inf` is implicit.
+     */
+    static constexpr std::uint64_t bounds[] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000 };
+
+    /**
+     * @brief The maximum number of types observed within the domain.
+     */
+    static constexpr std::size_t capacity = 64;
+};
+
+/**
+ * @brief The count of a type.
+ */
+struct type_count
+{
+    std::size_t      id_;
+    std::string_view name_;
+    std::string_view base_;
+    std::uint64_t    count_;
+};
+
+namespace details {
+namespace type_counter {
+
+inline constexpr std::size_t cache_line_size = 64;
+
+/**
+ * @brief The counters of a domain.
+ *
+ * Each type has `Width` counters, e.g., a histogram has a counter for each
+ * bucket and a counter for the sum.
+ * Each thread owns a block of counters that is aligned to cache lines.
+ * A counter is only written by its owner thread, thus an increment is
+ * a relaxed load and a relaxed store, without read-modify-write or
+ * false sharing.
+ * The blocks are linked, so the aggregator can read the counters of all
+ * threads.
+ * When a thread exits, its counts are folded into the retired counts.
+ */
+template<class Tag, std::size_t Width = 1,
+         std::size_t Capacity = type_counter_traits<Tag>::capacity>
+class domain
+{
+public:
+    static constexpr std::size_t capacity = Capacity;
+    static constexpr std::size_t width = Width;
+    static constexpr std::size_t size = Capacity * Width;
+
+    struct alignas(cache_line_size) block
+    {
+        std::atomic<std::uint64_t> counts_[size];
+        block* prev_;
+        block* next_;
+    };
+
+    /**
+     * @brief Add to a counter of a type.
+     *
+     * @pre `slot < Width`.
+     */
+    static void add(std::size_t id, std::size_t slot, std::uint64_t n) noexcept
+    {
+        block* b = local_;
+        if (b && id < capacity)
+        {
+            auto& c = b->counts_[id * Width + slot];
+            c.store(c.load(std::memory_order_relaxed) + n,
+                    std::memory_order_relaxed);
+        }
+        else
+        {
+            add_slow(id, slot, n);
+        }
+    }
+
+    /**
+     * @brief Get a counter of a type summed over all threads.
+     */
+    static std::uint64_t load(std::size_t id, std::size_t slot)
+    {
+        if (id >= capacity)
+        {
+            return 0;
+        }
+        const std::size_t i = id * Width + slot;
+        auto& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        std::uint64_t sum = s.retired_[i].load(std::memory_order_relaxed);
+        for (block* b = s.head_; b; b = b->next_)
+        {
+            sum += b->counts_[i].load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Get the counters of all types summed over all threads.
+     *
+     * @param[out] counts It holds at least `n * Width` counts.
+     * @param[in]  n      The number of types.
+     *
+     * @pre `n <= capacity`.
+     */
+    static void load_all(std::uint64_t* counts, std::size_t n)
+    {
+        const std::size_t m = n * Width;
+        auto& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        for (std::size_t i = 0; i < m; ++i)
+        {
+            counts[i] = s.retired_[i].load(std::memory_order_relaxed);
+        }
+        for (block* b = s.head_; b; b = b->next_)
+        {
+            for (std::size_t i = 0; i < m; ++i)
+            {
+                counts[i] += b->counts_[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief The count of increments whose type IDs exceed the capacity.
+     */
+    static std::uint64_t overflow(void) noexcept
+    {
+        return state().overflow_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct state_t
+    {
+        std::mutex mutex_;
+        block* head_ = nullptr;
+        std::atomic<std::uint64_t> retired_[size] = {};
+        std::atomic<std::uint64_t> overflow_ {0};
+    };
+
+    static state_t& state(void)
+    {
+        static state_t s;
+        return s;
+    }
+
+    /**
+     * @brief Detach the block from the list when the thread exits.
+     */
+    struct owner
+    {
+        block* block_ = nullptr;
+
+        ~owner(void)
+        {
+            if (block_)
+            {
+                auto& s = state();
+                std::lock_guard<std::mutex> lock(s.mutex_);
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    s.retired_[i].fetch_add(
+                        block_->counts_[i].load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+                }
+                (block_->prev_ ? block_->prev_->next_ : s.head_) =
+                    block_->next_;
+                if (block_->next_)
+                {
+                    block_->next_->prev_ = block_->prev_;
+                }
+                delete block_;
+                local_ = nullptr;
+                exited_ = true;
+            }
+        }
+    };
+
+    static void add_slow(std::size_t id, std::size_t slot,
+                         std::uint64_t n) noexcept
+    {
+        auto& s = state();
+        if (id >= capacity)
+        {
+            s.overflow_.fetch_add(n, std::memory_order_relaxed);
+        }
+        else if (block* b = exited_ ? nullptr : attach())
+        {
+            b->counts_[id * Width + slot].fetch_add(
+                n, std::memory_order_relaxed);
+        }
+        else
+        {
+            // The thread is exiting, and its block has been folded, or the
+            // block cannot be allocated.
+            s.retired_[id * Width + slot].fetch_add(
+                n, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Attach a block to the thread.
+     *
+     * @return `nullptr` if the block cannot be allocated.
+     */
+    static block* attach(void) noexcept
+    {
+        thread_local owner o;
+        block* b = new (std::nothrow) block;
+        if (!b)
+        {
+            return nullptr;
+        }
+        for (auto& c : b->counts_)
+        {
+            c.store(0, std::memory_order_relaxed);
+        }
+        auto& s = state();
+        {
+            std::lock_guard<std::mutex> lock(s.mutex_);
+            b->prev_ = nullptr;
+            b->next_ = s.head_;
+            if (s.head_)
+            {
+                s.head_->prev_ = b;
+            }
+            s.head_ = b;
+        }
+        o.block_ = b;
+        local_ = b;
+        return b;
+    }
+
+    static inline thread_local block* local_ = nullptr;
+    static inline thread_local bool exited_ = false;
+};
+
+/**
+ * @brief The labels of the types of a domain, i.e., their names escaped as
+ *        OpenMetrics label values at compile time, indexed by the type IDs.
+ *
+ * The types of a domain are registered here, so that the IDs and the labels
+ * agree.
+ */
+template<class Domain>
+class labels
+{
+public:
+    /**
+     * @brief Register a type.
+     *
+     * @return The ID of the type.
+     */
+    static std::size_t add(const type_info_entry& entry,
+                           std::string_view label)
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        const std::size_t id = type_registry<Domain>::add(entry);
+        if (s.labels_.size() <= id)
+        {
+            s.labels_.resize(id + 1);
+        }
+        s.labels_[id] = label;
+        return id;
+    }
+
+    /**
+     * @brief Get the registered types and their labels.
+     */
+    static void snapshot(std::vector<type_info_entry>& entries,
+                         std::vector<std::string_view>& out)
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        type_registry<Domain>::snapshot(entries);
+        out.assign(s.labels_.begin(), s.labels_.end());
+        out.resize(entries.size());
+    }
+
+private:
+    struct state_t
+    {
+        std::mutex mutex_;
+        std::deque<std::string_view> labels_;
+    };
+
+    static state_t& state(void)
+    {
+        static state_t s;
+        return s;
+    }
+};
+
+/**
+ * @brief The dense ID of a type within a domain, which registers the label
+ *        of the type along with it.
+ */
+template<class T, class Domain>
+struct labelled_id
+{
+    static inline const std::size_t value = labels<Domain>::add(
+        type_info_entry{
+            type_name_v<T>.view(),
+            type_base_v<T>.view(),
+            nsfx::type_name<T>::hash()},
+        escaped_name_v<openmetrics, T>.view());
+};
+
+/**
+ * @brief Load the registered types and their counters of a domain.
+ *
+ * @param[out] entries The registered types, limited by the capacity.
+ * @param[out] counts  `Domain::width` counters for each type.
+ */
+template<class Domain>
+void load(std::vector<type_info_entry>& entries,
+          std::vector<std::uint64_t>& counts)
+{
+    type_registry<Domain>::snapshot(entries);
+    if (entries.size() > Domain::capacity)
+    {
+        entries.resize(Domain::capacity);
+    }
+    counts.resize(entries.size() * Domain::width);
+    Domain::load_all(counts.data(), entries.size());
+}
+
+/**
+ * @brief Load the registered types, their labels, and their counters of
+ *        a domain.
+ *
+ * @param[out] label_values The label of each type.
+ */
+template<class Domain>
+void load(std::vector<type_info_entry>& entries,
+          std::vector<std::string_view>& label_values,
+          std::vector<std::uint64_t>& counts)
+{
+    labels<Domain>::snapshot(entries, label_values);
+    if (entries.size() > Domain::capacity)
+    {
+        entries.resize(Domain::capacity);
+        label_values.resize(Domain::capacity);
+    }
+    counts.resize(entries.size() * Domain::width);
+    Domain::load_all(counts.data(), entries.size());
+}
+
+} // namespace type_counter
+} // namespace details
+
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief A per-type counter.
+ *
+ * Each type is assigned a dense ID within the domain `Tag` by static
+ * registration (see `type_registry<>`), along with its name escaped as an
+ * OpenMetrics label value (see `openmetrics_exporter`).
+ * An increment indexes the counter block of the calling thread by the ID.
+ *
+ * @tparam T   The counted type.
+ * @tparam Tag The tag of the counter domain.
+ */
+template<class T, class Tag = void>
+struct type_counter
+{
+    using domain_type = details::type_counter::domain<Tag>;
+
+    /**
+     * @brief Get the ID of the type within the domain.
+     */
+    static std::size_t id(void) noexcept
+    {
+        return details::type_counter::labelled_id<T, domain_type>::value;
+    }
+
+    static void add(std::uint64_t n) noexcept
+    {
+        domain_type::add(id(), 0, n);
+    }
+
+    static void increment(void) noexcept
+    {
+        domain_type::add(id(), 0, 1);
+    }
+
+    /**
+     * @brief Get the count summed over all threads.
+     */
+    static std::uint64_t load(void)
+    {
+        return domain_type::load(id(), 0);
+    }
+};
+
+/**
+ * @brief The aggregator of the counters within a domain.
+ *
+ * @tparam Tag The tag of the counter domain.
+ */
+template<class Tag = void>
+struct type_counters
+{
+    using domain_type = details::type_counter::domain<Tag>;
+    using registry_type = type_registry<domain_type>;
+
+    /**
+     * @brief Take a snapshot of the counts of all types.
+     *
+     * The types are ordered by their IDs, and labelled by their names.
+     *
+     * @param[out] out It is cleared before the counts are appended.
+     *                 Reuse it to avoid allocation.
+     */
+    static void snapshot(std::vector<type_count>& out)
+    {
+        // They are not cached in `thread_local`s, since it may be called at
+        // exit, after the thread-local objects have been destroyed.
+        std::vector<type_info_entry> entries;
+        std::vector<std::uint64_t> counts;
+        load(entries, counts);
+        out.clear();
+        for (std::size_t id = 0; id < entries.size(); ++id)
+        {
+            out.push_back(type_count{
+                id, entries[id].name_, entries[id].base_, counts[id]});
+        }
+    }
+
+    static std::vector<type_count> snapshot(void)
+    {
+        std::vector<type_count> out;
+        snapshot(out);
+        return out;
+    }
+
+    /**
+     * @brief Load the registered types and their counts.
+     *
+     * @param[out] entries The registered types ordered by their IDs.
+     * @param[out] counts  The count of each type.
+     */
+    static void load(std::vector<type_info_entry>& entries,
+                     std::vector<std::uint64_t>& counts)
+    {
+        details::type_counter::load<domain_type>(entries, counts);
+    }
+
+    /**
+     * @brief Load the registered types, their labels, and their counts.
+     *
+     * @param[out] labels The name of each type escaped as an OpenMetrics
+     *                    label value.
+     */
+    static void load(std::vector<type_info_entry>& entries,
+                     std::vector<std::string_view>& labels,
+                     std::vector<std::uint64_t>& counts)
+    {
+        details::type_counter::load<domain_type>(entries, labels, counts);
+    }
+
+    /**
+     * @brief The count of increments whose type IDs exceed the capacity.
+     */
+    static std::uint64_t overflow(void) noexcept
+    {
+        return domain_type::overflow();
+    }
+};
+
+/**
+ * @brief A per-type histogram of unsigned integer observations.
+ *
+ * It shares the design of `type_counter<>`: each bucket and the sum are
+ * counters in the block of the calling thread.
+ *
+ * @tparam T   The observed type.
+ * @tparam Tag The tag of the histogram domain.
+ *             The buckets are given by `type_histogram_traits<Tag>::bounds`.
+ */
+template<class T, class Tag = void>
+struct type_histogram
+{
+    using traits_type = type_histogram_traits<Tag>;
+
+    /**
+     * @brief The number of buckets, including the `+Inf` bucket.
+     */
+    static constexpr std::size_t num_buckets =
+        sizeof (traits_type::bounds) / sizeof (traits_type::bounds[0]) + 1;
+
+    /**
+     * @brief The counters of a type: the buckets, and the sum.
+     */
+    using domain_type = details::type_counter::domain<
+        Tag, num_buckets + 1, traits_type::capacity>;
+
+    static std::size_t id(void) noexcept
+    {
+        return details::type_counter::labelled_id<T, domain_type>::value;
+    }
+
+    static void observe(std::uint64_t value) noexcept
+    {
+        std::size_t bucket = 0;
+        while (bucket < num_buckets - 1 && traits_type::bounds[bucket] < value)
+        {
+            ++bucket;
+        }
+        const std::size_t i = id();
+        domain_type::add(i, bucket, 1);
+        domain_type::add(i, num_buckets, value);
+    }
+
+    /**
+     * @brief Get the number of observations summed over all threads.
+     */
+    static std::uint64_t count(void)
+    {
+        std::uint64_t n = 0;
+        for (std::size_t bucket = 0; bucket < num_buckets; ++bucket)
+        {
+            n += domain_type::load(id(), bucket);
+        }
+        return n;
+    }
+
+    /**
+     * @brief Get the sum of observations summed over all threads.
+     */
+    static std::uint64_t sum(void)
+    {
+        return domain_type::load(id(), num_buckets);
+    }
+};
+
+/**
+ * @brief The aggregator of the histograms within a domain.
+ *
+ * @tparam Tag The tag of the histogram domain.
+ */
+template<class Tag = void>
+struct type_histograms
+{
+    using domain_type = typename type_histogram<void, Tag>::domain_type;
+    using traits_type = type_histogram_traits<Tag>;
+
+    /**
+     * @brief The number of buckets, including the `+Inf` bucket.
+     */
+    static constexpr std::size_t num_buckets =
+        type_histogram<void, Tag>::num_buckets;
+
+    /**
+     * @brief Load the registered types and their histograms.
+     *
+     * @param[out] entries The registered types ordered by their IDs.
+     * @param[out] counts  `num_buckets + 1` counters for each type:
+     *                     the non-cumulative count of each bucket, and the sum.
+     */
+    static void load(std::vector<type_info_entry>& entries,
+                     std::vector<std::uint64_t>& counts)
+    {
+        details::type_counter::load<domain_type>(entries, counts);
+    }
+
+    /**
+     * @brief Load the registered types, their labels, and their histograms.
+     *
+     * @param[out] labels The name of each type escaped as an OpenMetrics
+     *                    label value.
+     */
+    static void load(std::vector<type_info_entry>& entries,
+                     std::vector<std::string_view>& labels,
+                     std::vector<std::uint64_t>& counts)
+    {
+        details::type_counter::load<domain_type>(entries, labels, counts);
+    }
+};
+
+} // namespace nsfx
+
+
+#endif // TYPE_COUNTER_HPP__A93E1F57_2C4B_4D8E_B0A6_7C5F3D1E9B28
@@ -0,0 +1,296 @@
+/**
+ * @file
+ *
+ * @brief Escape type names at compile time.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#ifndef TYPE_ESCAPE_HPP__3F6A8C2E_D15B_4E97_9A04_B7C2E5F18D63
+#define TYPE_ESCAPE_HPP__3F6A8C2E_D15B_4E97_9A04_B7C2E5F18D63
+
+#include "type-name.hpp"
+
+#include <cstddef>
+#include <string_view>
+
+
+namespace nsfx {
+
+/**
+ * @brief The label values of the OpenMetrics (and Prometheus) text format.
+ *
+ * `\`, `"` and line feed are escaped by `\`.
+ */
+struct openmetrics {};
+
+/**
+ * @brief The contents of JSON strings.
+ *
+ * `"` and `\` are escaped by `\`, and control characters are escaped as
+ * `\uXXXX`.
+ */
+struct json {};
+
+/**
+ * @brief The contents of XML elements and attribute values.
+ *
+ * `<`, `>`, `&`, `"` and `'` are escaped as entities.
+ */
+struct xml {};
+
+/**
+ * @brief The fields of CSV (RFC 4180).
+ *
+ * The field is quoted by `"`, and `"` is doubled.
+ */
+struct csv {};
+
+/**
+ * @brief The words of POSIX shells.
+ *
+ * The word is quoted by `'`, and `'` is escaped as `'\''`.
+ */
+struct shell {};
+
+/**
+ * @brief The traits of an escape format.
+ *
+ * A specialization provides:
+ * * `prefix` and `suffix`: the strings that enclose the escaped string.
+ * * `max_expansion`: the maximum number of characters to escape a character.
+ * * `escape(c, dst)`: escape a character, and return the number of
+ *   characters written.
+ */
+template<class Format>
+struct escape_traits;
+
+template<>
+struct escape_traits<openmetrics>
+{
+    static constexpr std::string_view prefix {};
+    static constexpr std::string_view suffix {};
+    static constexpr std::size_t max_expansion = 2;
+
+    static constexpr std::size_t escape(char c, char* dst) noexcept
+    {
+        switch (c)
+        {
+        case '\\': dst[0] = '\\'; dst[1] = '\\'; return 2;
+        case '"':  dst[0] = '\\'; dst[1] = '"';  return 2;
+        case '\n': dst[0] = '\\'; dst[1] = 'n';  return 2;
+        default:   dst[0] = c;                   return 1;
+        }
+    }
+};
+
+template<>
+struct escape_traits<json>
+{
+    static constexpr std::string_view prefix {};
+    static constexpr std::string_view suffix {};
+    static constexpr std::size_t max_expansion = 6;
+
+    static constexpr std::size_t escape(char c, char* dst) noexcept
+    {
+        constexpr char hex[] = "0123456789abcdef";
+        switch (c)
+        {
+        case '"':  dst[0] = '\\'; dst[1] = '"';  return 2;
+        case '\\': dst[0] = '\\'; dst[1] = '\\'; return 2;
+        case '\b': dst[0] = '\\'; dst[1] = 'b';  return 2;
+        case '\f': dst[0] = '\\'; dst[1] = 'f';  return 2;
+        case '\n': dst[0] = '\\'; dst[1] = 'n';  return 2;
+        case '\r': dst[0] = '\\'; dst[1] = 'r';  return 2;
+        case '\t': dst[0] = '\\'; dst[1] = 't';  return 2;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                dst[0] = '\\';
+                dst[1] = 'u';
+                dst[2] = '0';
+                dst[3] = '0';
+                dst[4] = hex[(c >> 4) & 0x0f];
+                dst[5] = hex[c & 0x0f];
+                return 6;
+            }
+            dst[0] = c;
+            return 1;
+        }
+    }
+};
+
+template<>
+struct escape_traits<xml>
+{
+    static constexpr std::string_view prefix {};
+    static constexpr std::string_view suffix {};
+    static constexpr std::size_t max_expansion = 6;
+
+    static constexpr std::size_t escape(char c, char* dst) noexcept
+    {
+        std::string_view entity;
+        switch (c)
+        {
+        case '<':  entity = "&lt;";   break;
+        case '>':  entity = "&gt;";   break;
+        case '&':  entity = "&amp;";  break;
+        case '"':  entity = "&quot;"; break;
+        case '\'': entity = "&apos;"; break;
+        default:   dst[0] = c;        return 1;
+        }
+        for (std::size_t i = 0; i < entity.size(); ++i)
+        {
+            dst[i] = entity[i];
+        }
+        return entity.size();
+    }
+};
+
+template<>
+struct escape_traits<csv>
+{
+    static constexpr std::string_view prefix {"\""};
+    static constexpr std::string_view suffix {"\""};
+    static constexpr std::size_t max_expansion = 2;
+
+    static constexpr std::size_t escape(char c, char* dst) noexcept
+    {
+        if (c == '"')
+        {
+            dst[0] = '"';
+            dst[1] = '"';
+            return 2;
+        }
+        dst[0] = c;
+        return 1;
+    }
+};
+
+template<>
+struct escape_traits<shell>
+{
+    static constexpr std::string_view prefix {"'"};
+    static constexpr std::string_view suffix {"'"};
+    static constexpr std::size_t max_expansion = 4;
+
+    static constexpr std::size_t escape(char c, char* dst) noexcept
+    {
+        if (c == '\'')
+        {
+            // Close the quote, escape the quote, and reopen the quote.
+            dst[0] = '\'';
+            dst[1] = '\\';
+            dst[2] = '\'';
+            dst[3] = '\'';
+            return 4;
+        }
+        dst[0] = c;
+        return 1;
+    }
+};
+
+namespace details {
+namespace type_escape {
+
+/**
+ * @brief Get the length of an escaped string.
+ */
+template<class Format, std::size_t N>
+constexpr std::size_t escaped_size(const fixed_string_t<N>& str) noexcept
+{
+    using traits = escape_traits<Format>;
+    char buf[traits::max_expansion] {};
+    std::size_t size = traits::prefix.size() + traits::suffix.size();
+    for (std::size_t i = 0; i < str.size_; ++i)
+    {
+        size += traits::escape(str[i], buf);
+    }
+    return size;
+}
+
+/**
+ * @brief Escape a string.
+ *
+ * @pre The capacity of `dst` is larger than `escaped_size<Format>(str)`.
+ */
+template<class Format, std::size_t N, std::size_t M>
+constexpr void escape_to(const fixed_string_t<N>& str,
+                         fixed_string_t<M>& dst) noexcept
+{
+    using traits = escape_traits<Format>;
+    dst.size_ = 0;
+    for (const char c : traits::prefix)
+    {
+        dst[dst.size_++] = c;
+    }
+    for (std::size_t i = 0; i < str.size_; ++i)
+    {
+        dst.size_ += traits::escape(str[i], dst.data_ + dst.size_);
+    }
+    for (const char c : traits::suffix)
+    {
+        dst[dst.size_++] = c;
+    }
+    dst[dst.size_] = '\0';
+}
+
+/**
+ * @brief Escape a string with static storage duration.
+ *
+ * The capacity of the result is exactly the escaped length plus one.
+ */
+template<class Format, const auto& S>
+constexpr auto escape_exact(void) noexcept
+{
+    constexpr std::size_t L = escaped_size<Format>(S);
+    fixed_string_t<L+1> dst {};
+    escape_to<Format>(S, dst);
+    return dst;
+}
+
+} // namespace type_escape
+} // namespace details
+
+
+/**
+ * @brief Escape a string.
+ *
+ * The capacity of the result is large enough for any string of the same
+ * capacity.
+ * Use `escaped_name_v<>` to obtain an escaped type name that is trimmed.
+ *
+ * @tparam Format The escape format.
+ *
+ * @return The returned `fixed_string_t<>` is zero-terminated.
+ */
+template<class Format, std::size_t N>
+constexpr auto escape(const fixed_string_t<N>& str) noexcept
+{
+    using traits = escape_traits<Format>;
+    constexpr std::size_t M = (N - 1) * traits::max_expansion
+                            + traits::prefix.size() + traits::suffix.size();
+    fixed_string_t<M+1> dst {};
+    details::type_escape::escape_to<Format>(str, dst);
+    return dst;
+}
+
+/**
+ * @brief The escaped type name with static storage duration.
+ *
+ * @tparam Format The escape format.
+ */
+template<class Format, class T>
+inline constexpr auto escaped_name_v =
+    details::type_escape::escape_exact<Format, type_name_v<T>>();
+
+} // namespace nsfx
+
+
+#endif // TYPE_ESCAPE_HPP__3F6A8C2E_D15B_4E97_9A04_B7C2E5F18D63
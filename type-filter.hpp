@@ -0,0 +1,259 @@
+/**
+ * @file
+ *
+ * @brief Per-type log levels configured by type-name patterns.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#ifndef TYPE_FILTER_HPP__3D9B71C6_58E0_4A2F_B7D4_0E6C5A82F149
+#define TYPE_FILTER_HPP__3D9B71C6_58E0_4A2F_B7D4_0E6C5A82F149
+
+#include "type-id.hpp"
+#include "type-glob.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace nsfx {
+
+/**
+ * @brief The severity of a log record.
+ *
+ * A record is enabled if its level is not less than the threshold of its
+ * type.
+ * `off` as a threshold disables all records.
+ */
+enum class log_level : std::uint8_t
+{
+    trace,
+    debug,
+    info,
+    warning,
+    error,
+    fatal,
+    off,
+};
+
+/**
+ * @brief The traits of a filter domain.
+ *
+ * Specialize it to change the capacity or the default threshold of
+ * a domain.
+ *
+ * @tparam Tag The tag of the domain.
+ */
+template<class Tag>
+struct type_filter_traits
+{
+    /**
+     * @brief The maximum number of types filtered within the domain.
+     *
+     * The types beyond the capacity use the default threshold.
+     */
+    static constexpr std::size_t capacity = 1024;
+    /**
+     * @brief The threshold of the types that match no rule.
+     */
+    static constexpr log_level default_level = log_level::info;
+};
+
+/**
+ * @brief A rule of a filter: the types whose names match the glob pattern
+ *        (see `glob_match()`) have the threshold.
+ */
+struct type_filter_rule
+{
+    std::string_view pattern_;
+    log_level        level_;
+};
+
+namespace details {
+namespace type_filter {
+
+/**
+ * @brief The thresholds of a domain, which are constant initialized to the
+ *        default threshold.
+ */
+template<std::size_t N>
+struct thresholds
+{
+    std::atomic<log_level> levels_[N];
+
+    template<std::size_t... Is>
+    constexpr thresholds(log_level level, std::index_sequence<Is...>) noexcept
+        : levels_{((void)Is, level)...}
+    {
+    }
+};
+
+} // namespace type_filter
+} // namespace details
+
+
+/**
+ * @brief Per-type log thresholds.
+ *
+ * Each type is assigned a dense ID within the domain `Tag` by static
+ * registration (see `type_registry<>`).
+ * The thresholds are kept in a flat array indexed by the IDs plus one, thus
+ * `enabled<T>(level)` is a load of the index and a load of the threshold.
+ *
+ * The index of a type is `0` before its dynamic initialization, e.g., if
+ * `enabled<T>()` is called within the initializer of a static variable.
+ * Index `0` is reserved for such types, and always holds the default
+ * threshold.
+ *
+ * The thresholds are set from rules matched against the names of the
+ * registered types, and each threshold is updated atomically.
+ * The rules are not kept: call `configure()` after the types have been
+ * registered, i.e., after the start of `main()`.
+ *
+ * @code
+ * using filter = nsfx::type_filter<>;
+ * filter::configure({{"net::*", nsfx::log_level::debug},
+ *                    {"net::codec::*", nsfx::log_level::off}});
+ * if (filter::enabled<net::session>(nsfx::log_level::debug)) { ... }
+ * @endcode
+ *
+ * @tparam Tag The tag of the filter domain.
+ */
+template<class Tag = void>
+class type_filter
+{
+public:
+    using traits_type = type_filter_traits<Tag>;
+
+    static constexpr std::size_t capacity = traits_type::capacity;
+
+    /**
+     * @brief The domain of the type IDs.
+     */
+    struct domain {};
+
+    using registry_type = type_registry<domain>;
+
+    /**
+     * @brief Get the ID of a type within the domain.
+     *
+     * @pre The type has been registered, i.e., it is not called before the
+     *      dynamic initialization of the type's index.
+     */
+    template<class T>
+    static std::size_t id(void) noexcept
+    {
+        return index_<T> - 1;
+    }
+
+    /**
+     * @brief Check whether the records of a type at a level are enabled.
+     */
+    template<class T>
+    static bool enabled(log_level level) noexcept
+    {
+        return level >= threshold<T>();
+    }
+
+    /**
+     * @brief Get the threshold of a type.
+     */
+    template<class T>
+    static log_level threshold(void) noexcept
+    {
+        const std::size_t i = index_<T>;
+        return i <= capacity
+             ? table_.levels_[i].load(std::memory_order_relaxed)
+             : traits_type::default_level;
+    }
+
+    /**
+     * @brief Set the threshold of a type.
+     *
+     * It is ignored before the type is registered.
+     */
+    template<class T>
+    static void set(log_level level) noexcept
+    {
+        const std::size_t i = index_<T>;
+        if (i && i <= capacity)
+        {
+            table_.levels_[i].store(level, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Set the thresholds of the registered types by rules.
+     *
+     * The threshold of a type is given by the last rule that matches its
+     * name, or the default threshold if no rule matches.
+     * The patterns are compiled into a DFA (see `type_glob`), and each name
+     * is matched once.
+     *
+     * @return The number of types that match a rule.
+     */
+    static std::size_t configure(const std::vector<type_filter_rule>& rules)
+    {
+        std::vector<std::string_view> patterns;
+        for (const auto& r : rules)
+        {
+            patterns.push_back(r.pattern_);
+        }
+        const type_glob glob(patterns);
+        std::vector<type_info_entry> entries;
+        registry_type::snapshot(entries);
+        std::size_t matched = 0;
+        for (std::size_t i = 0; i < entries.size() && i < capacity; ++i)
+        {
+            const std::size_t k = glob.match(entries[i].name_);
+            matched += k != type_glob::npos;
+            table_.levels_[i + 1].store(k != type_glob::npos
+                                        ? rules[k].level_
+                                        : traits_type::default_level,
+                                    std::memory_order_relaxed);
+        }
+        return matched;
+    }
+
+    /**
+     * @brief Set the thresholds of all types to the default threshold.
+     */
+    static void reset(void) noexcept
+    {
+        for (auto& l : table_.levels_)
+        {
+            l.store(traits_type::default_level, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    /**
+     * @brief The index of a type in the table, i.e., its ID plus one.
+     *
+     * The type is registered here rather than by `type_id<T, domain>`, whose
+     * initialization is unordered with respect to this variable.
+     */
+    template<class T>
+    static inline const std::size_t index_ = 1 + registry_type::add(
+        type_info_entry{type_name_v<T>.view(), type_base_v<T>.view(),
+                        type_name<T>::hash()});
+
+    // Index `0` is reserved for the types that are not registered yet.
+    static inline details::type_filter::thresholds<capacity + 1> table_ {
+        traits_type::default_level, std::make_index_sequence<capacity + 1>{}};
+};
+
+} // namespace nsfx
+
+
+#endif // TYPE_FILTER_HPP__3D9B71C6_58E0_4A2F_B7D4_0E6C5A82F149
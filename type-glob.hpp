@@ -0,0 +1,359 @@
+/**
+ * @file
+ *
+ * @brief Match type names against glob patterns.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#ifndef TYPE_GLOB_HPP__A47D2E95_0C6B_4B13_8F5A_E3B9160C7D28
+#define TYPE_GLOB_HPP__A47D2E95_0C6B_4B13_8F5A_E3B9160C7D28
+
+#include "type-name.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <string_view>
+#include <vector>
+
+
+namespace nsfx {
+
+/**
+ * @brief Match a string against a glob pattern.
+ *
+ * * `*` matches any sequence of characters, including `::`.
+ * * `?` matches any character.
+ * * `\` escapes the next character.
+ * * Any other character matches itself.
+ *
+ * It can be evaluated at compile time, e.g., against `type_name_v<T>`.
+ *
+ * @code
+ * static_assert(nsfx::glob_match("std::vector<*>",
+ *                                nsfx::type_name_v<std::vector<int>>.view()));
+ * @endcode
+ */
+constexpr bool glob_match(std::string_view pattern,
+                          std::string_view str) noexcept
+{
+    constexpr std::size_t npos = std::string_view::npos;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    // The position after the last `*`, and the position in the string where
+    // the `*` is retried.
+    std::size_t star = npos;
+    std::size_t mark = 0;
+    while (j < str.size())
+    {
+        if (i < pattern.size() && pattern[i] == '*')
+        {
+            star = ++i;
+            mark = j;
+            continue;
+        }
+        if (i < pattern.size())
+        {
+            char c = pattern[i];
+            std::size_t width = 1;
+            bool any = c == '?';
+            if (c == '\\' && i + 1 < pattern.size())
+            {
+                c = pattern[i + 1];
+                width = 2;
+                any = false;
+            }
+            if (any || c == str[j])
+            {
+                i += width;
+                ++j;
+                continue;
+            }
+        }
+        if (star == npos)
+        {
+            return false;
+        }
+        // Let the last `*` match one more character.
+        i = star;
+        j = ++mark;
+    }
+    while (i < pattern.size() && pattern[i] == '*')
+    {
+        ++i;
+    }
+    return i == pattern.size();
+}
+
+/**
+ * @brief Match the name of a type against a glob pattern at compile time.
+ */
+template<class T>
+constexpr bool type_glob_match(std::string_view pattern) noexcept
+{
+    return glob_match(pattern, type_name_v<T>.view());
+}
+
+
+/**
+ * @brief A set of glob patterns compiled into a DFA.
+ *
+ * The syntax of the patterns is that of `glob_match()`.
+ * A match is a walk of the DFA, i.e., a table lookup per character, no
+ * matter how many patterns there are.
+ * The characters are mapped to classes, i.e., the characters that appear
+ * literally in the patterns, and the rest, so the table is small.
+ *
+ * @code
+ * nsfx::type_glob g({"ns::detail::*", "std::vector<*>"});
+ * g.match(name);           // the index of the last matching pattern
+ * g.matches<my_type>();
+ * @endcode
+ *
+ * @remark
+ *   The number of states can grow exponentially with the number of `*` in
+ *   the worst case, but it is linear for the usual prefix and suffix
+ *   patterns.
+ *   Compile the patterns once, e.g., when the configuration is loaded.
+ */
+class type_glob
+{
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    explicit type_glob(std::string_view pattern)
+    {
+        compile(&pattern, &pattern + 1);
+    }
+
+    explicit type_glob(std::initializer_list<std::string_view> patterns)
+    {
+        compile(patterns.begin(), patterns.end());
+    }
+
+    explicit type_glob(const std::vector<std::string_view>& patterns)
+    {
+        compile(patterns.data(), patterns.data() + patterns.size());
+    }
+
+    /**
+     * @brief Match a string.
+     *
+     * @return The index of the last matching pattern, or `npos`.
+     */
+    std::size_t match(std::string_view str) const noexcept
+    {
+        std::uint32_t s = start_;
+        for (const char c : str)
+        {
+            const std::uint32_t k = classes_[static_cast<unsigned char>(c)];
+            s = next_[s * num_classes_ + k];
+            if (s == dead)
+            {
+                return npos;
+            }
+        }
+        return accept_[s];
+    }
+
+    bool matches(std::string_view str) const noexcept
+    {
+        return match(str) != npos;
+    }
+
+    /**
+     * @brief Match the name of a type.
+     */
+    template<class T>
+    bool matches(void) const noexcept
+    {
+        return matches(type_name_v<T>.view());
+    }
+
+    std::size_t num_patterns(void) const noexcept
+    {
+        return num_patterns_;
+    }
+
+    std::size_t num_states(void) const noexcept
+    {
+        return accept_.size();
+    }
+
+private:
+    /**
+     * @brief The state that matches nothing.
+     */
+    static constexpr std::uint32_t dead = 0;
+
+    struct token
+    {
+        enum kind_t : unsigned char { literal, any, star, end };
+        kind_t kind_;
+        char c_;
+        // The index of the pattern of an `end` token.
+        std::size_t pattern_;
+    };
+
+    using state_set = std::vector<std::uint64_t>;
+
+    void compile(const std::string_view* first, const std::string_view* last)
+    {
+        num_patterns_ = static_cast<std::size_t>(last - first);
+        // The tokens of all patterns, each followed by an `end` token.
+        // A position is the index of the token to match next.
+        std::vector<token> tokens;
+        std::vector<std::size_t> starts;
+        bool literal[256] = {};
+        for (std::size_t k = 0; first + k != last; ++k)
+        {
+            const std::string_view p = first[k];
+            starts.push_back(tokens.size());
+            for (std::size_t i = 0; i < p.size(); ++i)
+            {
+                if (p[i] == '*')
+                {
+                    // Consecutive `*` are the same as one.
+                    if (tokens.size() == starts.back() ||
+                        tokens.back().kind_ != token::star)
+                    {
+                        tokens.push_back(token{token::star, 0, k});
+                    }
+                }
+                else if (p[i] == '?')
+                {
+                    tokens.push_back(token{token::any, 0, k});
+                }
+                else
+                {
+                    if (p[i] == '\\' && i + 1 < p.size())
+                    {
+                        ++i;
+                    }
+                    tokens.push_back(token{token::literal, p[i], k});
+                    literal[static_cast<unsigned char>(p[i])] = true;
+                }
+            }
+            tokens.push_back(token{token::end, 0, k});
+        }
+        // Class 0 holds the characters that are not in the patterns.
+        num_classes_ = 1;
+        std::vector<char> representatives(1, 0);
+        for (std::size_t c = 0; c < 256; ++c)
+        {
+            classes_[c] = 0;
+            if (literal[c])
+            {
+                classes_[c] = static_cast<std::uint32_t>(num_classes_++);
+                representatives.push_back(static_cast<char>(c));
+            }
+        }
+        // The subset construction.
+        const std::size_t words = (tokens.size() + 63) / 64;
+        std::map<state_set, std::uint32_t> ids;
+        std::vector<state_set> sets;
+        auto add = [&] (state_set set) {
+            auto it = ids.find(set);
+            if (it != ids.end())
+            {
+                return it->second;
+            }
+            const auto id = static_cast<std::uint32_t>(sets.size());
+            ids.emplace(set, id);
+            sets.push_back(std::move(set));
+            return id;
+        };
+        add(state_set(words));
+        state_set initial(words);
+        for (const std::size_t s : starts)
+        {
+            initial[s / 64] |= std::uint64_t{1} << (s % 64);
+        }
+        start_ = add(closure(tokens, std::move(initial)));
+        for (std::size_t id = 0; id < sets.size(); ++id)
+        {
+            std::size_t accept = npos;
+            for (std::size_t i = 0; i < tokens.size(); ++i)
+            {
+                if (has(sets[id], i) && tokens[i].kind_ == token::end)
+                {
+                    accept = tokens[i].pattern_;
+                }
+            }
+            accept_.push_back(accept);
+            for (std::size_t k = 0; k < num_classes_; ++k)
+            {
+                state_set next(words);
+                for (std::size_t i = 0; i < tokens.size(); ++i)
+                {
+                    if (!has(sets[id], i))
+                    {
+                        continue;
+                    }
+                    const token& t = tokens[i];
+                    if (t.kind_ == token::star)
+                    {
+                        next[i / 64] |= std::uint64_t{1} << (i % 64);
+                    }
+                    else if (t.kind_ == token::any ||
+                             (t.kind_ == token::literal && k &&
+                              t.c_ == representatives[k]))
+                    {
+                        next[(i + 1) / 64] |=
+                            std::uint64_t{1} << ((i + 1) % 64);
+                    }
+                }
+                // `sets` may be reallocated by `add()`.
+                const std::uint32_t to =
+                    add(closure(tokens, std::move(next)));
+                next_.push_back(to);
+            }
+        }
+    }
+
+    static bool has(const state_set& set, std::size_t i) noexcept
+    {
+        return (set[i / 64] >> (i % 64)) & 1;
+    }
+
+    /**
+     * @brief Add the positions after the `*` in a set.
+     *
+     * A `*` may match nothing.
+     */
+    static state_set closure(const std::vector<token>& tokens, state_set set)
+    {
+        // A `*` is never followed by another `*`, so a single pass is enough.
+        for (std::size_t i = 0; i < tokens.size(); ++i)
+        {
+            if (has(set, i) && tokens[i].kind_ == token::star)
+            {
+                set[(i + 1) / 64] |= std::uint64_t{1} << ((i + 1) % 64);
+            }
+        }
+        return set;
+    }
+
+    std::size_t num_patterns_ = 0;
+    std::size_t num_classes_ = 0;
+    std::uint32_t start_ = dead;
+    std::uint32_t classes_[256] = {};
+    // `next_[s * num_classes_ + k]` is the state after state `s` reads
+    // a character of class `k`.
+    std::vector<std::uint32_t> next_;
+    // The index of the last pattern accepted by each state, or `npos`.
+    std::vector<std::size_t> accept_;
+};
+
+} // namespace nsfx
+
+
+#endif // TYPE_GLOB_HPP__A47D2E95_0C6B_4B13_8F5A_E3B9160C7D28
@@ -0,0 +1,148 @@
+/**
+ * @file
+ *
+ * @brief Dense type IDs by static registration.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#ifndef TYPE_ID_HPP__5D8B2F4A_9C6E_4B13_A7F0_3E1D5C9B7A42
+#define TYPE_ID_HPP__5D8B2F4A_9C6E_4B13_A7F0_3E1D5C9B7A42
+
+#include "type-name.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+
+namespace nsfx {
+
+/**
+ * @brief The information of a registered type.
+ */
+struct type_info_entry
+{
+    std::string_view name_;
+    std::string_view base_;
+    std::uint64_t    hash_;
+};
+
+/**
+ * @brief A registry of types within a domain.
+ *
+ * Each type registered in a domain is assigned a dense ID within `[0, size())`
+ * in the order of registration.
+ * The registration happens during the dynamic initialization of
+ * `type_id<T, Domain>::value`, i.e., before `main()` in practice.
+ *
+ * The IDs are dense but **not** stable across builds.
+ * Use `type_name<T>::hash()` to identify types across processes.
+ *
+ * @tparam Domain A tag type that separates the ID spaces.
+ */
+template<class Domain = void>
+class type_registry
+{
+public:
+    /**
+     * @brief Register a type.
+     *
+     * It is thread-safe.
+     *
+     * @return The ID of the type.
+     */
+    static std::size_t add(const type_info_entry& entry)
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        s.entries_.push_back(entry);
+        return s.entries_.size() - 1;
+    }
+
+    /**
+     * @brief Get the number of registered types.
+     */
+    static std::size_t size(void)
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        return s.entries_.size();
+    }
+
+    /**
+     * @brief Get the information of a registered type.
+     *
+     * @pre `id < size()`.
+     */
+    static type_info_entry get(std::size_t id)
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        return s.entries_[id];
+    }
+
+    static std::string_view name(std::size_t id)
+    {
+        return get(id).name_;
+    }
+
+    /**
+     * @brief Get the information of all registered types.
+     *
+     * @param[out] out It is cleared before the entries are appended.
+     *                 Reuse it to avoid allocation.
+     */
+    static void snapshot(std::vector<type_info_entry>& out)
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        out.assign(s.entries_.begin(), s.entries_.end());
+    }
+
+private:
+    struct state_t
+    {
+        std::mutex mutex_;
+        std::deque<type_info_entry> entries_;
+    };
+
+    static state_t& state(void)
+    {
+        static state_t s;
+        return s;
+    }
+};
+
+/**
+ * @brief The dense ID of a type within a domain.
+ *
+ * Reading `value` is a single load.
+ *
+ * @remark
+ *   The value is `0` before the dynamic initialization of the variable.
+ *   Do not use it within the initializers of other static variables.
+ */
+template<class T, class Domain = void>
+struct type_id
+{
+    static inline const std::size_t value = type_registry<Domain>::add(
+        type_info_entry{
+            type_name_v<T>.view(),
+            type_base_v<T>.view(),
+            type_name<T>::hash()});
+};
+
+} // namespace nsfx
+
+
+#endif // TYPE_ID_HPP__5D8B2F4A_9C6E_4B13_A7F0_3E1D5C9B7A42
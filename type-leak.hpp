@@ -0,0 +1,191 @@
+/**
+ * @file
+ *
+ * @brief Report the live objects of the type pools by type name.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#ifndef TYPE_LEAK_HPP__9F3B6D20_E7A1_4C58_B14D_62C8A0E5F7B3
+#define TYPE_LEAK_HPP__9F3B6D20_E7A1_4C58_B14D_62C8A0E5F7B3
+
+#include "type-pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+
+namespace nsfx {
+
+/**
+ * @brief The live objects of a group of types.
+ */
+struct type_leak
+{
+    /**
+     * @brief The name or the base name of the types.
+     */
+    std::string_view name_;
+    std::uint64_t    objects_;
+    std::uint64_t    bytes_;
+};
+
+/**
+ * @brief The key to group the types by.
+ */
+enum class leak_grouping
+{
+    name,
+    base,
+};
+
+namespace details {
+namespace type_leak {
+
+inline std::ostream*& report_stream(void) noexcept
+{
+    static std::ostream* os = nullptr;
+    return os;
+}
+
+} // namespace type_leak
+} // namespace details
+
+
+/**
+ * @brief Report the live objects of all type pools (see `type_pool<>`).
+ *
+ * The pools only keep counters, and the names are resolved when a report is
+ * made.
+ * Thus, the accounting costs nothing beyond the pools themselves.
+ *
+ * @code
+ * int main(void)
+ * {
+ *     nsfx::type_leaks::report_at_exit(std::cerr);
+ *     ...
+ * }
+ * @endcode
+ */
+struct type_leaks
+{
+    /**
+     * @brief Collect the live objects grouped by the names or the base names.
+     *
+     * The groups without live objects are omitted, and the groups are sorted
+     * by the bytes in descending order.
+     * The bytes are counted by the size classes of the pools.
+     */
+    static std::vector<type_leak>
+    collect(leak_grouping grouping = leak_grouping::name)
+    {
+        std::vector<type_leak> leaks;
+        for (const auto& s : type_pools::snapshot())
+        {
+            if (!s.live_)
+            {
+                continue;
+            }
+            const std::string_view key =
+                grouping == leak_grouping::name ? s.name_ : s.base_;
+            auto it = std::find_if(leaks.begin(), leaks.end(),
+                                   [&] (const type_leak& l) {
+                                       return l.name_ == key;
+                                   });
+            if (it == leaks.end())
+            {
+                it = leaks.insert(leaks.end(), type_leak{key, 0, 0});
+            }
+            it->objects_ += s.live_;
+            it->bytes_ += s.live_ * s.object_size_;
+        }
+        std::stable_sort(leaks.begin(), leaks.end(),
+                         [] (const type_leak& a, const type_leak& b) {
+                             return a.bytes_ > b.bytes_;
+                         });
+        return leaks;
+    }
+
+    /**
+     * @brief Write a report of the live objects.
+     *
+     * @return The number of bytes of the live objects.
+     */
+    static std::uint64_t report(std::ostream& os,
+                                leak_grouping grouping = leak_grouping::name)
+    {
+        const std::vector<type_leak> leaks = collect(grouping);
+        std::uint64_t objects = 0;
+        std::uint64_t bytes = 0;
+        for (const auto& l : leaks)
+        {
+            objects += l.objects_;
+            bytes += l.bytes_;
+        }
+        os << "live objects by "
+           << (grouping == leak_grouping::name ? "name" : "base") << ": "
+           << leaks.size() << " types, " << objects << " objects, "
+           << bytes << " bytes\n";
+        if (!leaks.empty())
+        {
+            os << std::setw(14) << "bytes" << std::setw(12) << "objects"
+               << "  type\n";
+        }
+        for (const auto& l : leaks)
+        {
+            os << std::setw(14) << l.bytes_ << std::setw(12) << l.objects_
+               << "  " << l.name_ << "\n";
+        }
+        os.flush();
+        return bytes;
+    }
+
+    /**
+     * @brief Write the reports grouped by the names and the base names at
+     *        exit.
+     *
+     * The report is written by a function registered by `std::atexit()`,
+     * i.e., after the destruction of the static objects that are constructed
+     * after the call.
+     * Call it early, e.g., at the start of `main()`, so that the objects
+     * released by those destructors are not reported.
+     *
+     * @param[in] os It must be valid at exit, e.g., `std::cerr`.
+     *
+     * @return `false` if the report has been enabled already, in which case
+     *         the stream is replaced.
+     */
+    static bool report_at_exit(std::ostream& os)
+    {
+        static std::atomic<bool> enabled {false};
+        details::type_leak::report_stream() = &os;
+        if (enabled.exchange(true))
+        {
+            return false;
+        }
+        std::atexit([] {
+            std::ostream& s = *details::type_leak::report_stream();
+            report(s, leak_grouping::name);
+            report(s, leak_grouping::base);
+        });
+        return true;
+    }
+};
+
+} // namespace nsfx
+
+
+#endif // TYPE_LEAK_HPP__9F3B6D20_E7A1_4C58_B14D_62C8A0E5F7B3
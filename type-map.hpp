@@ -0,0 +1,300 @@
+/**
+ * @file
+ *
+ * @brief Flat maps keyed by types.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#ifndef TYPE_MAP_HPP__1E6A9C43_B825_4D07_93F1_C7D42E8B05A6
+#define TYPE_MAP_HPP__1E6A9C43_B825_4D07_93F1_C7D42E8B05A6
+
+#include "type-name.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace nsfx {
+
+/**
+ * @brief A map from types to values.
+ *
+ * The keys are the type hashes (`type_name<T>::hash()`), which are
+ * compile-time constants.
+ * The entries are kept in a single array by open addressing with linear
+ * probing, and at most half of the slots are used.
+ *
+ * The home slot of a type is its constant hash masked by the table size, so
+ * the common lookup is a load and a compare of the slot.
+ * A lookup never writes, and the maps share no state.
+ *
+ * Distinct types with the same hash are kept apart: the name of a type is
+ * stored with its hash, and compared only if the hashes are equal (see
+ * `component_registry<>`).
+ *
+ * @code
+ * nsfx::type_map<service*> services;
+ * services.insert_or_assign<logger>(&my_logger);
+ * logger* l = static_cast<logger*>(services.get<logger>());
+ * @endcode
+ *
+ * @tparam V The type of the values.
+ *           It must be default constructible and move assignable.
+ */
+template<class V>
+class type_map
+{
+public:
+    using value_type = V;
+
+    type_map(void)
+        : slots_(16),
+          mask_(15),
+          count_(0)
+    {
+    }
+
+    /**
+     * @brief Find the value of a type.
+     *
+     * @return `nullptr` if the type is not in the map.
+     */
+    template<class T>
+    V* find(void) noexcept
+    {
+        return const_cast<V*>(static_cast<const type_map*>(this)->find<T>());
+    }
+
+    template<class T>
+    const V* find(void) const noexcept
+    {
+        constexpr std::uint64_t key = type_name<T>::hash();
+        static_assert(key != empty_key, "The type hash is reserved.");
+        const std::size_t i = probe(key, type_name_v<T>.view());
+        return slots_[i].key_ ? &slots_[i].value_ : nullptr;
+    }
+
+    /**
+     * @brief Get the value of a type.
+     *
+     * @pre `contains<T>()`.
+     */
+    template<class T>
+    V& get(void) noexcept
+    {
+        return *find<T>();
+    }
+
+    template<class T>
+    const V& get(void) const noexcept
+    {
+        return *find<T>();
+    }
+
+    template<class T>
+    bool contains(void) const noexcept
+    {
+        return find<T>() != nullptr;
+    }
+
+    /**
+     * @brief Set the value of a type.
+     *
+     * @return The value in the map.
+     */
+    template<class T, class U>
+    V& insert_or_assign(U&& value)
+    {
+        V& v = slot_of<T>();
+        v = std::forward<U>(value);
+        return v;
+    }
+
+    /**
+     * @brief Get the value of a type, and insert a default constructed value
+     *        if the type is not in the map.
+     */
+    template<class T>
+    V& operator()(void)
+    {
+        return slot_of<T>();
+    }
+
+    /**
+     * @brief Remove the value of a type.
+     *
+     * @return `false` if the type is not in the map.
+     */
+    template<class T>
+    bool erase(void)
+    {
+        constexpr std::uint64_t key = type_name<T>::hash();
+        std::size_t i = probe(key, type_name_v<T>.view());
+        if (!slots_[i].key_)
+        {
+            return false;
+        }
+        // Shift the subsequent entries of the cluster backward, so that the
+        // probes are not broken by the hole.
+        for (std::size_t j = (i + 1) & mask_; slots_[j].key_;
+             j = (j + 1) & mask_)
+        {
+            const std::size_t home = slots_[j].key_ & mask_;
+            // Move the entry if its home is not within `(i, j]`.
+            if (((j - home) & mask_) >= ((j - i) & mask_))
+            {
+                slots_[i] = std::move(slots_[j]);
+                i = j;
+            }
+        }
+        slots_[i] = slot{};
+        --count_;
+        return true;
+    }
+
+    std::size_t size(void) const noexcept
+    {
+        return count_;
+    }
+
+    bool empty(void) const noexcept
+    {
+        return !count_;
+    }
+
+    void clear(void)
+    {
+        for (slot& s : slots_)
+        {
+            s = slot{};
+        }
+        count_ = 0;
+    }
+
+    /**
+     * @brief Visit the entries.
+     *
+     * @param[in] visitor Called with the type hash and the value.
+     */
+    template<class Visitor>
+    void for_each(Visitor&& visitor)
+    {
+        for (slot& s : slots_)
+        {
+            if (s.key_)
+            {
+                visitor(s.key_, s.value_);
+            }
+        }
+    }
+
+    template<class Visitor>
+    void for_each(Visitor&& visitor) const
+    {
+        for (const slot& s : slots_)
+        {
+            if (s.key_)
+            {
+                visitor(s.key_, s.value_);
+            }
+        }
+    }
+
+private:
+    /**
+     * @brief The key of empty slots.
+     */
+    static constexpr std::uint64_t empty_key = 0;
+
+    struct slot
+    {
+        std::uint64_t key_ = empty_key;
+        std::string_view name_;
+        V value_ {};
+    };
+
+    /**
+     * @brief Find the slot of a type, or the empty slot to insert it.
+     *
+     * @param[in] key  The hash of the type.
+     * @param[in] name The name of the type.
+     */
+    std::size_t probe(std::uint64_t key, std::string_view name) const noexcept
+    {
+        std::size_t i = static_cast<std::size_t>(key) & mask_;
+        while (slots_[i].key_ &&
+               (slots_[i].key_ != key ||
+                (slots_[i].name_.data() != name.data() &&
+                 slots_[i].name_ != name)))
+        {
+            i = (i + 1) & mask_;
+        }
+        return i;
+    }
+
+    /**
+     * @brief Find the empty slot to move an entry into.
+     */
+    std::size_t vacant(std::uint64_t key) const noexcept
+    {
+        std::size_t i = static_cast<std::size_t>(key) & mask_;
+        while (slots_[i].key_)
+        {
+            i = (i + 1) & mask_;
+        }
+        return i;
+    }
+
+    template<class T>
+    V& slot_of(void)
+    {
+        if (V* v = find<T>())
+        {
+            return *v;
+        }
+        constexpr std::uint64_t key = type_name<T>::hash();
+        if (2 * (count_ + 1) > slots_.size())
+        {
+            grow();
+        }
+        const std::size_t i = vacant(key);
+        slots_[i].key_ = key;
+        slots_[i].name_ = type_name_v<T>.view();
+        ++count_;
+        return slots_[i].value_;
+    }
+
+    void grow(void)
+    {
+        std::vector<slot> old(2 * slots_.size());
+        old.swap(slots_);
+        mask_ = slots_.size() - 1;
+        for (slot& s : old)
+        {
+            if (s.key_)
+            {
+                slots_[vacant(s.key_)] = std::move(s);
+            }
+        }
+    }
+
+    // The size is a power of 2, and at most half of the slots are used.
+    std::vector<slot> slots_;
+    std::size_t mask_;
+    std::size_t count_;
+};
+
+} // namespace nsfx
+
+
+#endif // TYPE_MAP_HPP__1E6A9C43_B825_4D07_93F1_C7D42E8B05A6
@@ -0,0 +1,165 @@
+/**
+ * @file
+ *
+ * @brief Bitmasks of type sets at compile time.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#ifndef TYPE_MASK_HPP__6C0E4B91_3A7D_4F28_B5E6_D81F29A4C073
+#define TYPE_MASK_HPP__6C0E4B91_3A7D_4F28_B5E6_D81F29A4C073
+
+#include "type-order.hpp"
+#include "fixed-bitset.hpp"
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+
+namespace nsfx {
+
+namespace details {
+namespace type_mask {
+
+template<class List>
+struct table;
+
+template<class... Ts>
+struct table<type_list<Ts...>>
+{
+    static constexpr std::array<std::string_view, sizeof...(Ts)> names_ = {
+        type_name_v<Ts>.view()... };
+
+    /**
+     * @brief Whether the sorted names are distinct.
+     */
+    static constexpr bool unique(void) noexcept
+    {
+        for (std::size_t i = 1; i < sizeof...(Ts); ++i)
+        {
+            if (names_[i - 1] == names_[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace type_mask
+} // namespace details
+
+
+/**
+ * @brief A universe of types, whose positions are the ranks of their names.
+ *
+ * The positions are canonical: they do not depend upon the order in which
+ * the types are declared, so the masks agree across builds and processes as
+ * long as the universe is the same.
+ *
+ * @tparam Universe A `type_list<>`.
+ *                  The names of the types **must** be distinct.
+ */
+template<class Universe>
+struct type_universe
+{
+    /**
+     * @brief The types sorted by their names.
+     */
+    using sorted_type = type_sort_t<Universe>;
+
+private:
+    using table_ = details::type_mask::table<sorted_type>;
+
+    static_assert(table_::unique(),
+                  "The names of the types must be distinct.");
+
+public:
+    static constexpr std::size_t size = Universe::size;
+
+    using bitset_type = fixed_bitset<size>;
+
+    /**
+     * @brief Get the position of a type.
+     */
+    template<class T>
+    static constexpr std::size_t position(void) noexcept
+    {
+        return type_position_v<T, sorted_type>;
+    }
+
+    /**
+     * @brief Get the name of the type at a position.
+     *
+     * @pre `i < size`.
+     */
+    static constexpr std::string_view name(std::size_t i) noexcept
+    {
+        return table_::names_[i];
+    }
+
+    /**
+     * @brief Get the mask of a set of types.
+     */
+    template<class... Ts>
+    static constexpr bitset_type mask(void) noexcept
+    {
+        bitset_type result;
+        (result.set(position<Ts>()), ...);
+        return result;
+    }
+
+    /**
+     * @brief Test whether a type is in a mask.
+     *
+     * It is a single bit test, since the position is a constant.
+     */
+    template<class T>
+    static constexpr bool test(const bitset_type& mask) noexcept
+    {
+        constexpr std::size_t i = position<T>();
+        return mask.test(i);
+    }
+};
+
+/**
+ * @brief The mask of a set of types within a universe.
+ *
+ * The `i`-th bit indicates whether the type at position `i` of the universe
+ * (see `type_universe<>`) is in the set.
+ *
+ * @code
+ * using messages = nsfx::type_list<ping, pong, chat, quit>;
+ * constexpr auto wanted = nsfx::type_mask_v<messages, ping, quit>;
+ * if (nsfx::type_universe<messages>::test<pong>(wanted)) { ... }
+ * @endcode
+ *
+ * @tparam Universe A `type_list<>`.
+ * @tparam Ts       The types in the set.
+ *                  They **must** be in the universe.
+ */
+template<class Universe, class... Ts>
+struct type_mask
+{
+    using universe_type = type_universe<Universe>;
+    using bitset_type = typename universe_type::bitset_type;
+
+    static constexpr bitset_type value =
+        universe_type::template mask<Ts...>();
+};
+
+template<class Universe, class... Ts>
+inline constexpr typename type_universe<Universe>::bitset_type type_mask_v =
+    type_mask<Universe, Ts...>::value;
+
+} // namespace nsfx
+
+
+#endif // TYPE_MASK_HPP__6C0E4B91_3A7D_4F28_B5E6_D81F29A4C073
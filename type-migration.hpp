@@ -0,0 +1,254 @@
+/**
+ * @file
+ *
+ * @brief Lazy migration of persisted types by versioned hashes.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#ifndef TYPE_MIGRATION_HPP__B7E21C4D_6A39_4F58_8C0E_2D9F4A71B536
+#define TYPE_MIGRATION_HPP__B7E21C4D_6A39_4F58_8C0E_2D9F4A71B536
+
+#include "type-name.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace nsfx {
+
+/**
+ * @brief A migration of a type from an older version.
+ *
+ * @tparam T The type of the current version.
+ */
+template<class T>
+struct type_migration
+{
+    /**
+     * @brief Convert the data of the older version into the current version.
+     *
+     * @return `false` if the data is malformed.
+     */
+    using function_type = bool (*)(const void* data, std::size_t size, T& out);
+
+    /**
+     * @brief `type_name<T>::versioned_hash<version_>()`.
+     */
+    std::uint64_t hash_;
+    std::uint32_t version_;
+    function_type migrate_;
+};
+
+/**
+ * @brief A migration of a type from an older version that is known at
+ *        compile time.
+ *
+ * It converts to `type_migration<T>`.
+ * `make_migration_table()` checks the versions of such migrations at compile
+ * time.
+ *
+ * @tparam T       The type of the current version.
+ * @tparam Version The older version.
+ */
+template<class T, std::uint32_t Version>
+struct versioned_migration
+{
+    static constexpr std::uint64_t hash =
+        type_name<T>::template versioned_hash<Version>();
+    static constexpr std::uint32_t version = Version;
+
+    typename type_migration<T>::function_type migrate_;
+
+    constexpr operator type_migration<T>(void) const noexcept
+    {
+        return type_migration<T>{hash, Version, migrate_};
+    }
+};
+
+/**
+ * @brief Make a migration of a type from an older version.
+ *
+ * @tparam T       The type of the current version.
+ * @tparam Version The older version.
+ */
+template<class T, std::uint32_t Version>
+constexpr versioned_migration<T, Version>
+migrate_from(typename type_migration<T>::function_type f) noexcept
+{
+    static_assert(Version != type_version_v<T>,
+                  "The current version needs no migration.");
+    return versioned_migration<T, Version>{f};
+}
+
+namespace details {
+namespace type_migration {
+
+template<class T, class M>
+struct is_migration_of : std::false_type {};
+
+template<class T, std::uint32_t Version>
+struct is_migration_of<T, versioned_migration<T, Version>> : std::true_type {};
+
+/**
+ * @brief Check whether the hashes are distinct, and differ from the hash of
+ *        the current version.
+ */
+template<std::size_t N>
+constexpr bool unique(std::uint64_t current,
+                      const std::array<std::uint64_t, N>& hashes) noexcept
+{
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        if (hashes[i] == current)
+        {
+            return false;
+        }
+        for (std::size_t j = i + 1; j < N; ++j)
+        {
+            if (hashes[i] == hashes[j])
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace type_migration
+} // namespace details
+
+/**
+ * @brief A table that maps the hashes of the older versions of a type to
+ *        their migrations.
+ *
+ * Data that is keyed by `type_name<T>::versioned_hash()` can be migrated
+ * lazily when it is read, instead of being rewritten when the layout of
+ * the type changes.
+ *
+ * @code
+ * constexpr auto table = nsfx::make_migration_table<record>(
+ *     nsfx::migrate_from<record, 1>(&from_v1),
+ *     nsfx::migrate_from<record, 2>(&from_v2));
+ * record r;
+ * if (hash == table.current)
+ * {
+ *     // Decode the current version.
+ * }
+ * else if (table.migrate(hash, data, size, r))
+ * {
+ *     // Optionally, write it back with the current hash.
+ * }
+ * @endcode
+ *
+ * @tparam T The type of the current version.
+ * @tparam N The number of older versions.
+ */
+template<class T, std::size_t N>
+class type_migration_table
+{
+public:
+    /**
+     * @brief The hash of the current version.
+     */
+    static constexpr std::uint64_t current =
+        type_name<T>::versioned_hash();
+
+    template<class... Ms>
+    constexpr explicit type_migration_table(const Ms&... migrations) noexcept
+        : migrations_{{static_cast<type_migration<T>>(migrations)...}}
+    {
+    }
+
+    /**
+     * @brief Find the migration of an older version.
+     *
+     * @return `nullptr` if the hash is unknown.
+     */
+    constexpr const type_migration<T>* find(std::uint64_t hash) const noexcept
+    {
+        for (const auto& m : migrations_)
+        {
+            if (m.hash_ == hash)
+            {
+                return &m;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Check whether the hash is the current version, or an older
+     *        version that can be migrated.
+     */
+    constexpr bool knows(std::uint64_t hash) const noexcept
+    {
+        return hash == current || find(hash);
+    }
+
+    /**
+     * @brief Migrate the data of an older version.
+     *
+     * @return `false` if the hash is unknown, or the data is malformed.
+     */
+    bool migrate(std::uint64_t hash, const void* data, std::size_t size,
+                 T& out) const
+    {
+        const type_migration<T>* m = find(hash);
+        return m && m->migrate_(data, size, out);
+    }
+
+    /**
+     * @brief Check whether the hashes of the versions are distinct.
+     */
+    constexpr bool unique(void) const noexcept
+    {
+        std::array<std::uint64_t, N> hashes {};
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            hashes[i] = migrations_[i].hash_;
+        }
+        return details::type_migration::unique(current, hashes);
+    }
+
+private:
+    std::array<type_migration<T>, N> migrations_;
+};
+
+/**
+ * @brief Make a migration table.
+ *
+ * The versions are checked at compile time: they must be distinct, and
+ * differ from the current version.
+ *
+ * @tparam T The type of the current version.
+ *
+ * @param[in] migrations See `migrate_from()`.
+ */
+template<class T, class... Ms>
+constexpr type_migration_table<T, sizeof... (Ms)>
+make_migration_table(const Ms&... migrations) noexcept
+{
+    static_assert((details::type_migration::is_migration_of<T, Ms>::value
+                   && ...),
+                  "The migrations must be made by migrate_from<T, Version>().");
+    static_assert(details::type_migration::unique(
+                      type_name<T>::versioned_hash(),
+                      std::array<std::uint64_t, sizeof... (Ms)>{{Ms::hash...}}),
+                  "The versions of the migrations must be distinct, and "
+                  "differ from the current version.");
+    return type_migration_table<T, sizeof... (Ms)>{migrations...};
+}
+
+} // namespace nsfx
+
+
+#endif // TYPE_MIGRATION_HPP__B7E21C4D_6A39_4F58_8C0E_2D9F4A71B536
@@ -15,8 +15,15 @@
 #ifndef TYPE_NAME_HPP__9CFF9E19_0F21_4E1D_AE6F_C9A92C919C06
 #define TYPE_NAME_HPP__9CFF9E19_0F21_4E1D_AE6F_C9A92C919C06
 
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <string_view>
 #include <type_traits>
+#include <utility>
+#include <string>
 #include <iostream>
 
 
@@ -30,62 +37,125 @@
 # endif
 #endif // !defined(NSFX_FUNCTION)
 
+/**
+ * @brief Whether closure types are named stably.
+ *
+ * * `0`: closure types are named as printed by the compiler.
+ * * `1`: file paths, line numbers and compiler-generated hashes are removed
+ *   from the names of closure types and unnamed classes.
+ *   e.g., `(lambda at /src/a.cpp:12:5)` of clang and `<lambda_8f3e...>` of
+ *   msvc become `<lambda>`.
+ *
+ * In the stable mode, closure types that differ only in their locations
+ * have the same name and the same hash, thus collide as keys, e.g., of
+ * `type_map<>` or typed frames.
+ * Use `tagged<Tag, F>` to name such closures apart.
+ *
+ * It **must** be the same in all translation units.
+ */
+#if !defined(NSFX_TYPE_NAME_STABLE_LAMBDA)
+# define NSFX_TYPE_NAME_STABLE_LAMBDA  0
+#endif // !defined(NSFX_TYPE_NAME_STABLE_LAMBDA)
+
+/**
+ * @brief How the translation-unit-local scopes are named.
+ *
+ * * `0`: as printed by the compiler.
+ * * `1`: anonymous namespaces are spelled as `{anon}`, and the enclosing
+ *   functions of local classes are shortened to their qualified names.
+ *   e.g., `ns::(anonymous namespace)::X` becomes `ns::{anon}::X`, and
+ *   `ns::f<int>(int, std::vector<int>) const::X` becomes `ns::f<int>()::X`.
+ *   The types in anonymous namespaces of different translation units may
+ *   have the same name.
+ *   So may the local classes of overloads that differ only in their
+ *   parameters or qualifiers, e.g., those of `f(int)` and `f(double)` are
+ *   both `f()::X`, and have the same hash.
+ * * `2`: as `1`, but anonymous namespaces are spelled as
+ *   `{NSFX_TYPE_NAME_TU_TAG}`.
+ *   e.g., `ns::(anonymous namespace)::X` becomes `ns::{net.cpp}::X`.
+ *
+ * It **must** be the same in all translation units.
+ */
+#if !defined(NSFX_TYPE_NAME_LOCAL_SCOPE)
+# define NSFX_TYPE_NAME_LOCAL_SCOPE  0
+#endif // !defined(NSFX_TYPE_NAME_LOCAL_SCOPE)
+
+/**
+ * @brief The tag of the translation unit.
+ *
+ * It is a string literal that replaces the anonymous namespaces if
+ * `NSFX_TYPE_NAME_LOCAL_SCOPE` is `2`.
+ * It can differ among translation units.
+ * By default, it is the file name (without directories) of the main source
+ * file on g++ and clang.
+ */
+#if NSFX_TYPE_NAME_LOCAL_SCOPE == 2 && !defined(NSFX_TYPE_NAME_TU_TAG)
+# if defined(__BASE_FILE__)
+#  define NSFX_TYPE_NAME_TU_TAG  __BASE_FILE__
+# else
+#  error NSFX_TYPE_NAME_TU_TAG must be defined.
+# endif
+#endif
+
 
 namespace nsfx {
 
 /**
  * @brief A fixed length string.
  *
- * @tparam N The capacity of the string.
+ * @tparam CharT The character type.
+ * @tparam N     The capacity of the string.
  */
-template<std::size_t N>
-struct fixed_string_t
+template<class CharT, std::size_t N>
+struct basic_fixed_string
 {
-    char data_[N];
+    CharT data_[N];
     std::size_t size_;
 
+    using value_type = CharT;
+
     static constexpr std::size_t npos = (std::size_t)(-1);
     static constexpr std::size_t capacity_ = N;
 
-    constexpr fixed_string_t(void) noexcept = default;
+    constexpr basic_fixed_string(void) noexcept = default;
 
-    constexpr fixed_string_t(const char* str, std::size_t len) noexcept
-        : fixed_string_t{}
+    constexpr basic_fixed_string(const CharT* str, std::size_t len) noexcept
+        : basic_fixed_string{}
     {
         for (size_ = 0; size_ < len && size_ < N - 1; ++size_)
         {
             data_[size_] = str[size_];
         }
-        data_[size_] = '\0';
+        data_[size_] = CharT{};
     }
 
     template<std::size_t M>
-    constexpr fixed_string_t(const char (&str)[M]) noexcept
-        : fixed_string_t{}
+    constexpr basic_fixed_string(const CharT (&str)[M]) noexcept
+        : basic_fixed_string{}
     {
         for (size_ = 0; size_ < M - 1 && size_ < N - 1; ++size_)
         {
             data_[size_] = str[size_];
         }
-        data_[size_] = '\0';
+        data_[size_] = CharT{};
     }
 
-    constexpr std::string_view view(void) const noexcept
+    constexpr std::basic_string_view<CharT> view(void) const noexcept
     {
-        return std::string_view{data_, size_};
+        return std::basic_string_view<CharT>{data_, size_};
     }
 
-    constexpr char& operator[](std::size_t i) noexcept
+    constexpr CharT& operator[](std::size_t i) noexcept
     {
         return data_[i];
     }
 
-    constexpr const char& operator[](std::size_t i) const noexcept
+    constexpr const CharT& operator[](std::size_t i) const noexcept
     {
         return data_[i];
     }
 
-    constexpr std::size_t find(const char c) const noexcept
+    constexpr std::size_t find(const CharT c) const noexcept
     {
         if (size_)
         {
@@ -102,7 +172,7 @@ struct fixed_string_t
         return npos;
     }
 
-    constexpr std::size_t rfind(const char c) const noexcept
+    constexpr std::size_t rfind(const CharT c) const noexcept
     {
         std::size_t pos = size_ - 1;
         if (size_)
@@ -122,61 +192,160 @@ struct fixed_string_t
 };
 
 /**
- * @brief Make a fixed string from a string literal.
+ * @brief A fixed length narrow string.
+ *
+ * @tparam N The capacity of the string.
  */
 template<std::size_t N>
-constexpr fixed_string_t<N>
-to_fixed_string(const char (&src)[N]) noexcept
+using fixed_string_t = basic_fixed_string<char, N>;
+
+/**
+ * @brief Make a fixed string from a string literal.
+ */
+template<class CharT, std::size_t N>
+constexpr basic_fixed_string<CharT, N>
+to_fixed_string(const CharT (&src)[N]) noexcept
 {
-    return fixed_string_t<N>{src};
+    return basic_fixed_string<CharT, N>{src};
 }
 
+template<class T>
+struct type_name;
+
+/**
+ * @brief The customization point of type names.
+ *
+ * Specialize it to give a type an explicit name that survives refactoring,
+ * e.g., for wire protocols.
+ * A specialization provides:
+ * * `name`: a `std::string_view` constant, e.g., `"proto.Ping"`.
+ * * `hash` (optional): a `std::uint64_t` constant.
+ *   By default, it is the 64-bit FNV-1a hash of `name`.
+ *
+ * `type_name<T>::name()`, `base()`, `hash()`, `identifier()`, etc., and the
+ * facilities built upon them (e.g., `type_id<>` and `component_registry<>`)
+ * use the explicit name.
+ * `raw()` and `mangled()` still spell the type as the compiler does.
+ *
+ * The explicit name only applies to `T` itself.
+ * e.g., `const T*` and `std::vector<T>` are spelled by the compiler.
+ *
+ * The specialization **must** be declared before the type name is used.
+ *
+ * @code
+ * template<>
+ * struct nsfx::type_name_override<proto::ping>
+ * {
+ *     static constexpr std::string_view name = "proto.Ping";
+ * };
+ * @endcode
+ */
+template<class T>
+struct type_name_override {};
+
+/**
+ * @brief The version of a type.
+ *
+ * Specialize it when the layout of a persisted type changes, so that the
+ * data of different layouts are keyed by different hashes.
+ * The default version is `0`.
+ *
+ * @see `type_name<T>::versioned()`
+ */
+template<class T>
+struct type_version : std::integral_constant<std::uint32_t, 0> {};
+
+template<class T>
+inline constexpr std::uint32_t type_version_v = type_version<T>::value;
+
+/**
+ * @brief The type name with static storage duration.
+ *
+ * A `std::string_view` that refers to it is a constant expression.
+ */
+template<class T>
+inline constexpr auto type_name_v = type_name<T>::name();
+
 namespace details {
 namespace type_name {
 
-template<class T>
-struct full
+/**
+ * @brief The position and length of a name within a function signature.
+ */
+struct name_range
 {
-    // full<nsfx::Xxx>::get()
-    //
-    // g++  : static constexpr auto nsfx::details::type_name::full<T>::get() [with T = nsfx::Xxx]
-    //                                                                                 ^^^^^^^^^
-    // clang: static auto nsfx::details::type_name::full<nsfx:Xxx>::get() [T = nsfx::Xxx]
-    //                                                   ^^^^^^^^              ^^^^^^^^^
-    // msvc : auto __cdecl nsfx::details::type_name::full<struct nsfx::Xxx>::get(void)
-    //                                                    ^^^^^^^^^^^^^^^^
-    static constexpr auto get(void)
-    {
-        return std::string_view{NSFX_FUNCTION};
-    }
+    std::size_t pos_;
+    std::size_t size_;
 };
 
-// full<int>::get()
-//
-// g++  : static constexpr auto nsfx::details::type_name::full<T>::get() [with T = int]
-//                                                                                 ^^^
-// clang: static auto nsfx::details::type_name::full<int>::get() [T = int]
-//                                                   ^^^              ^^^
-// msvc : auto __cdecl nsfx::details::type_name::full<int>::get(void)
-//                                                    ^^^
-// The index of the first character of the type name.
-inline constexpr std::size_t name_start_pos = full<int>::get().find("int");
-
-// full<void>::get()
-//
-// g++  : static constexpr auto nsfx::details::type_name::full<T>::get() [with T = void]
-//                                                                                 ^^^^
-// clang: static auto nsfx::details::type_name::full<void>::get() [T = void]
-//                                                   ^^^^              ^^^^
-// msvc : auto __cdecl nsfx::details::type_name::full<void>::get(void)
-//                                                    ^^^^
-// How many times the type name appears in the full.
-inline constexpr std::size_t num_appearance = full<void>::get().size()
-                                            - full<int>::get().size();
-
-// The number of characters excluding the type name.
-inline constexpr std::size_t num_misc_chars = full<void>::get().size()
-                                            - 4 * num_appearance;
+/**
+ * @brief Locate the name of the template argument in a function signature.
+ *
+ * The name is located by the delimiters around it, rather than by its
+ * length, since the compilers may print the template argument differently
+ * in different parts of the signature.
+ *
+ * @code
+ * g++  : static constexpr auto nsfx::details::type_name::impl<T>::raw() [with T = nsfx::Xxx]
+ *                                                                                 ^^^^^^^^^
+ * clang: static auto nsfx::details::type_name::impl<nsfx::Xxx>::raw() [T = nsfx::Xxx]
+ *                                                                          ^^^^^^^^^
+ * msvc : auto __cdecl nsfx::details::type_name::impl<struct nsfx::Xxx>::raw(void)
+ *                                                    ^^^^^^^^^^^^^^^^
+ * @endcode
+ *
+ * The bracketed form of g++ and clang is preferred whenever it is present,
+ * since it also covers clang with `-fms-compatibility`.
+ * The name ends at the first `;`, `,` or `]` that is not enclosed by brackets,
+ * since g++ appends the typedefs used by the signature after a `;`.
+ * If the brackets within the name are not balanced (e.g., the address of
+ * `operator<`), the name ends at the last `]`.
+ *
+ * @param[in] with   The delimiter before the name in the form of g++.
+ * @param[in] param  The delimiter before the name in the form of clang.
+ * @param[in] open   The delimiter before the name in the form of msvc.
+ * @param[in] close  The delimiter after the name in the form of msvc.
+ */
+constexpr name_range locate(std::string_view full,
+                            std::string_view with,
+                            std::string_view param,
+                            std::string_view open,
+                            std::string_view close) noexcept
+{
+    std::size_t pos = full.find(with);
+    if (pos != full.npos)
+    {
+        pos += with.size();
+    }
+    else if ((pos = full.find(param)) != full.npos)
+    {
+        pos += param.size();
+    }
+    else
+    {
+        // msvc
+        pos = full.find(open) + open.size();
+        return name_range{pos, full.rfind(close) - pos};
+    }
+    int depth = 0;
+    for (std::size_t i = pos; i < full.size(); ++i)
+    {
+        const char c = full[i];
+        if (c == '<' || c == '(' || c == '[' || c == '{')
+        {
+            ++depth;
+        }
+        else if (depth && (c == '>' || c == ')' || c == ']' || c == '}'))
+        {
+            --depth;
+        }
+        else if (!depth && (c == ';' || c == ',' || c == ']'))
+        {
+            return name_range{pos, i - pos};
+        }
+    }
+    return name_range{pos, full.rfind(']') - pos};
+}
 
 /**
  * @brief Check whether a character is part of an identifier name.
@@ -258,193 +427,2100 @@ constexpr std::size_t match(
 }
 
 /**
- * @brief Get the raw type name of a type.
+ * @brief Decode a code point from an UTF-8 string.
  *
- * @remark
- *   Since `__PRETTY_FUNCTION__` and `__FUNCSIG__` contains the class name and
- *   member function name,
- *   the name length of class `impl` **must** be the same as
- *   the name length of class `full`, and
- *   the name length of member function `impl::get()` **must** be the same as
- *   the name length of member function `full::get()`.
- *   Therefore, the `name_start_pos`, `num_appearance` and `num_misc_chars`
- *   are consistent for the return values of `full::get()` and `impl::get()`.
+ * The type names produced by the compilers are assumed to be UTF-8 encoded.
+ * An ill-formed sequence is decoded as `U+FFFD`, and consumes one byte.
+ *
+ * @param[in]     str The UTF-8 string.
+ * @param[in]     len The length of the string.
+ * @param[in,out] pos The position of the first byte of the code point.
+ *                    It is advanced to the next code point.
  */
-template<class T>
-struct impl
+constexpr char32_t decode_utf8(const char* str, std::size_t len,
+                               std::size_t& pos) noexcept
 {
-    /**
-     * @brief Get the raw type name.
-     *
-     * @return The returned `fixed_string_t<>` is zero-terminated.
-     */
-    static constexpr auto raw(void)
+    const auto b0 = static_cast<unsigned char>(str[pos]);
+    // The number of continuation bytes.
+    std::size_t n = 0;
+    char32_t cp = 0;
+    if (b0 < 0x80)
     {
-        // `full` is zero-terminated.
-        constexpr auto full = to_fixed_string(NSFX_FUNCTION);
-        // Extract type name from `full`.
-        constexpr std::size_t N = full.capacity_;
-        constexpr std::size_t L = (N - 1 - num_misc_chars) / num_appearance;
-        // `name` is zero-terminated.
-        return fixed_string_t<L+1>{full.data_ + name_start_pos, L};
+        ++pos;
+        return b0;
     }
-
-    /**
-     * @brief Get the size of tidy type name.
-     *
-     * The keywords `enum`, `class`, `struct` and `__cdecl` are removed from
-     * the type name.
-     *
-     * @return The returned `fixed_string_t<>` is zero-terminated.
-     */
-    static constexpr std::size_t dry(void) noexcept
+    else if ((b0 & 0xe0) == 0xc0)
     {
-        auto name = raw();
-#if defined(__clang__) || defined(__GNUC__)
-        return name.capacity_;
-#elif defined(_MSC_VER)
-        constexpr std::size_t len = name.capacity_ - 1;
-        std::size_t size = 0;
-        std::size_t pos = 0;
-        while (true)
-        {
-            // The number of characters to remove.
-            std::size_t n = 0;
-            n = match(name, pos, len, "enum");
-            if (n) { pos += n; continue; }
-            n = match(name, pos, len, "class");
-            if (n) { pos += n; continue; }
-            n = match(name, pos, len, "struct");
-            if (n) { pos += n; continue; }
-            n = match(name, pos, len, "__cdecl");
-            if (n) { pos += n; continue; }
-            // The character before `sub` is not an identifier character.
-            while (pos < len && iskey(name[pos]))
-            {
-                ++size;
-                ++pos;
-            }
-            // The character before `sub` is not an identifier character.
-            while (pos < len && !iskey(name[pos]))
-            {
-                ++size;
-                ++pos;
-            }
-            // The current character is a non-identifier character.
-            if (pos == len)
-            {
-                break;
-            }
-        }
-        // Strip trailing spaces.
-        while (pos && name[pos - 1] == ' ')
+        n = 1;
+        cp = b0 & 0x1f;
+    }
+    else if ((b0 & 0xf0) == 0xe0)
+    {
+        n = 2;
+        cp = b0 & 0x0f;
+    }
+    else if ((b0 & 0xf8) == 0xf0)
+    {
+        n = 3;
+        cp = b0 & 0x07;
+    }
+    else
+    {
+        ++pos;
+        return 0xfffd;
+    }
+    // The sequence is truncated.
+    if (pos + n >= len)
+    {
+        ++pos;
+        return 0xfffd;
+    }
+    for (std::size_t i = 1; i <= n; ++i)
+    {
+        const auto b = static_cast<unsigned char>(str[pos + i]);
+        if ((b & 0xc0) != 0x80)
         {
-            --pos;
-            --size;
+            ++pos;
+            return 0xfffd;
         }
-        return size;
-#else
-# error Unsupported compiler.
-#endif
+        cp = (cp << 6) | (b & 0x3f);
     }
+    pos += n + 1;
+    return cp;
+}
 
-    /**
-     * @brief Get the tidy type name.
-     *
-     * The keywords `enum`, `class`, `struct` and `__cdecl` are removed from
-     * the type name.
-     *
-     * @return The returned `fixed_string_t<>` is zero-terminated.
-     */
-    static constexpr auto tidy(void) noexcept
+/**
+ * @brief The number of code units to encode a code point.
+ *
+ * `char` and `char8_t` use UTF-8, `char16_t` uses UTF-16,
+ * `char32_t` uses UTF-32, and `wchar_t` uses UTF-16 or UTF-32
+ * depending on its size.
+ */
+template<class CharT>
+constexpr std::size_t encoded_units(char32_t cp) noexcept
+{
+    if constexpr (sizeof (CharT) == 1)
     {
-        auto name = raw();
-#if defined(__clang__) || defined(__GNUC__)
-        return name;
-#elif defined(_MSC_VER)
-        constexpr std::size_t len = name.capacity_ - 1;
-        constexpr std::size_t L = dry();
-        fixed_string_t<L+1> dst {};
-        std::size_t pos = 0;
-        while (true)
-        {
-            // The number of characters to remove.
-            std::size_t n = 0;
-            n = match(name, pos, len, "enum");
-            if (n) { pos += n; continue; }
-            n = match(name, pos, len, "class");
-            if (n) { pos += n; continue; }
-            n = match(name, pos, len, "struct");
-            if (n) { pos += n; continue; }
-            n = match(name, pos, len, "__cdecl");
-            if (n) { pos += n; continue; }
-            // The character before `sub` is not an identifier character.
-            while (dst.size_ < L && pos < len && iskey(name[pos]))
-            {
-                dst[dst.size_++] = name[pos++];
-            }
-            // The character before `sub` is not an identifier character.
-            while (dst.size_ < L && pos < len && !iskey(name[pos]))
-            {
-                dst[dst.size_++] = name[pos++];
-            }
-            // The current character is a non-identifier character.
-            if (dst.size_ == L || pos == len)
-            {
-                break;
-            }
-        }
-        dst[L] = '\0';
-        return dst;
-#else
-# error Unsupported compiler.
-#endif
+        return cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+    }
+    else if constexpr (sizeof (CharT) == 2)
+    {
+        return cp < 0x10000 ? 1 : 2;
+    }
+    else
+    {
+        return 1;
     }
+}
 
-    /**
-     * @brief Get the unqualified type name.
-     *
-     * @pre The type **must** be a value type.
-     *
-     * @return The returned `fixed_string_t<>` is zero-terminated.
-     */
-    static constexpr auto base(void) noexcept
+/**
+ * @brief Encode a code point.
+ *
+ * @param[out] dst The buffer to hold the code units.
+ *
+ * @return The number of code units written.
+ */
+template<class CharT>
+constexpr std::size_t encode_unit(char32_t cp, CharT* dst) noexcept
+{
+    if constexpr (sizeof (CharT) == 1)
     {
-        if constexpr (std::is_const_v<T>     ||
-                      std::is_volatile_v<T>  ||
-                      std::is_array_v<T>     ||
-                      std::is_pointer_v<T>   ||
-                      std::is_reference_v<T> ||
-                      // T is not a function type, possibly qualified.
-                      // e.g., int (float)
-                      // e.g., int (float) const & noexcept
-                      std::is_function_v<T>  ||
-                      // T is not a member object pointer.
-                      // e.g., int (C::*)
-                      // T is not a member function pointer.
-                      // e.g., int (C::*)(float)
-                      std::is_member_pointer_v<T>)
+        if (cp < 0x80)
         {
-            return tidy();
+            dst[0] = static_cast<CharT>(cp);
+            return 1;
+        }
+        else if (cp < 0x800)
+        {
+            dst[0] = static_cast<CharT>(0xc0 | (cp >> 6));
+            dst[1] = static_cast<CharT>(0x80 | (cp & 0x3f));
+            return 2;
+        }
+        else if (cp < 0x10000)
+        {
+            dst[0] = static_cast<CharT>(0xe0 | (cp >> 12));
+            dst[1] = static_cast<CharT>(0x80 | ((cp >> 6) & 0x3f));
+            dst[2] = static_cast<CharT>(0x80 | (cp & 0x3f));
+            return 3;
         }
         else
         {
-            constexpr auto name = tidy();
-            // Find the last ':'.
-            constexpr std::size_t pos = name.rfind(':');
-            if constexpr (pos == name.npos)
+            dst[0] = static_cast<CharT>(0xf0 | (cp >> 18));
+            dst[1] = static_cast<CharT>(0x80 | ((cp >> 12) & 0x3f));
+            dst[2] = static_cast<CharT>(0x80 | ((cp >> 6) & 0x3f));
+            dst[3] = static_cast<CharT>(0x80 | (cp & 0x3f));
+            return 4;
+        }
+    }
+    else if constexpr (sizeof (CharT) == 2)
+    {
+        if (cp < 0x10000)
+        {
+            dst[0] = static_cast<CharT>(cp);
+            return 1;
+        }
+        else
+        {
+            cp -= 0x10000;
+            dst[0] = static_cast<CharT>(0xd800 | (cp >> 10));
+            dst[1] = static_cast<CharT>(0xdc00 | (cp & 0x3ff));
+            return 2;
+        }
+    }
+    else
+    {
+        dst[0] = static_cast<CharT>(cp);
+        return 1;
+    }
+}
+
+/**
+ * @brief Get the number of code units to transcode an UTF-8 string.
+ */
+template<class CharT, std::size_t N>
+constexpr std::size_t transcoded_size(const fixed_string_t<N>& str) noexcept
+{
+    std::size_t size = 0;
+    std::size_t pos = 0;
+    while (pos < str.size_)
+    {
+        size += encoded_units<CharT>(decode_utf8(str.data_, str.size_, pos));
+    }
+    return size;
+}
+
+/**
+ * @brief Transcode an UTF-8 string.
+ *
+ * @pre The capacity of `dst` is larger than `transcoded_size<CharT>(str)`.
+ */
+template<class CharT, std::size_t N, std::size_t M>
+constexpr void transcode(const fixed_string_t<N>& str,
+                         basic_fixed_string<CharT, M>& dst) noexcept
+{
+    std::size_t pos = 0;
+    dst.size_ = 0;
+    while (pos < str.size_)
+    {
+        dst.size_ += encode_unit(decode_utf8(str.data_, str.size_, pos),
+                                 dst.data_ + dst.size_);
+    }
+    dst[dst.size_] = CharT{};
+}
+
+/**
+ * @brief The 64-bit FNV-1a hash of a string.
+ *
+ * @param[in] h The hash to continue, i.e., the offset basis by default.
+ */
+constexpr std::uint64_t fnv1a(std::string_view str,
+                              std::uint64_t h = 0xcbf29ce484222325ull) noexcept
+{
+    for (const char c : str)
+    {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+/**
+ * @brief Get the position of the unqualified name in a tidy type name.
+ *
+ * The `::` within the template argument lists, the parameter lists and the
+ * array bounds are skipped.
+ * e.g., it is the position of `map` in `std::map<int, ns::C>`.
+ */
+constexpr std::size_t unqualified_pos(std::string_view name) noexcept
+{
+    std::size_t result = 0;
+    int depth = 0;
+    for (std::size_t pos = 0; pos < name.size(); ++pos)
+    {
+        const char c = name[pos];
+        if (c == '<' || c == '(' || c == '[')
+        {
+            ++depth;
+        }
+        else if (c == '>' || c == ')' || c == ']')
+        {
+            --depth;
+        }
+        else if (c == ':' && depth == 0 && pos + 1 < name.size() &&
+                 name[pos + 1] == ':')
+        {
+            result = pos + 2;
+            ++pos;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Get the position of the top-level template argument list in a tidy
+ *        type name.
+ *
+ * @return The position of the `<`, or `npos` if the type is not a template
+ *         specialization.
+ */
+constexpr std::size_t template_args_pos(std::string_view name) noexcept
+{
+    int depth = 0;
+    for (std::size_t pos = unqualified_pos(name); pos < name.size(); ++pos)
+    {
+        const char c = name[pos];
+        if (c == '(' || c == '[')
+        {
+            ++depth;
+        }
+        else if (c == ')' || c == ']')
+        {
+            --depth;
+        }
+        else if (c == '<' && depth == 0)
+        {
+            return pos;
+        }
+    }
+    return name.npos;
+}
+
+/**
+ * @brief Visit the top-level template arguments in a tidy type name.
+ *
+ * The surrounding spaces of the arguments are trimmed.
+ *
+ * @param[in] visit It is called with the index and the text of each argument.
+ *
+ * @return The number of template arguments.
+ */
+template<class Visitor>
+constexpr std::size_t for_each_template_arg(std::string_view name,
+                                            Visitor&& visit) noexcept
+{
+    const std::size_t open = template_args_pos(name);
+    if (open == name.npos)
+    {
+        return 0;
+    }
+    std::size_t count = 0;
+    std::size_t start = open + 1;
+    int depth = 0;
+    for (std::size_t pos = start; pos < name.size(); ++pos)
+    {
+        const char c = name[pos];
+        if (c == '<' || c == '(' || c == '[')
+        {
+            ++depth;
+        }
+        else if ((c == '>' || c == ')' || c == ']') && depth)
+        {
+            --depth;
+        }
+        else if (depth == 0 && (c == ',' || c == '>'))
+        {
+            std::string_view arg = name.substr(start, pos - start);
+            while (!arg.empty() && arg.front() == ' ')
+            {
+                arg.remove_prefix(1);
+            }
+            while (!arg.empty() && arg.back() == ' ')
+            {
+                arg.remove_suffix(1);
+            }
+            // `T<>` has no argument.
+            if (c == ',' || count || !arg.empty())
+            {
+                visit(count++, arg);
+            }
+            if (c == '>')
+            {
+                break;
+            }
+            start = pos + 1;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Get the top-level template arguments of a type.
+ *
+ * The strings refer to `type_name_v<T>`.
+ */
+template<class T>
+constexpr auto template_args(void) noexcept
+{
+    constexpr std::string_view name = nsfx::type_name_v<T>.view();
+    constexpr std::size_t N =
+        for_each_template_arg(name, [](std::size_t, std::string_view) {});
+    std::array<std::string_view, N> args {};
+    for_each_template_arg(name, [&](std::size_t i, std::string_view arg) {
+        args[i] = arg;
+    });
+    return args;
+}
+
+/**
+ * @brief A sink that counts the characters.
+ */
+struct counting_sink
+{
+    std::size_t size_ = 0;
+
+    constexpr void put(char) noexcept
+    {
+        ++size_;
+    }
+};
+
+/**
+ * @brief A sink that appends the characters to a fixed string.
+ */
+template<std::size_t N>
+struct string_sink
+{
+    fixed_string_t<N>& dst_;
+
+    constexpr void put(char c) noexcept
+    {
+        dst_[dst_.size_++] = c;
+    }
+};
+
+/**
+ * @brief Put the decimal digits of a non-negative integer.
+ */
+template<class Sink, class I>
+constexpr void put_decimal(Sink& sink, I n) noexcept
+{
+    char digits[40] {};
+    std::size_t k = 0;
+    do
+    {
+        digits[k++] = static_cast<char>('0' + n % 10);
+        n /= 10;
+    }
+    while (n);
+    while (k)
+    {
+        sink.put(digits[--k]);
+    }
+}
+
+/**
+ * @brief Get the length of a transformed string.
+ *
+ * @tparam Transform It provides `apply(str, sink)` that puts the transformed
+ *                   characters into the sink.
+ */
+template<class Transform, std::size_t N>
+constexpr std::size_t transformed_size(const fixed_string_t<N>& str) noexcept
+{
+    counting_sink sink;
+    Transform::apply(str, sink);
+    return sink.size_;
+}
+
+/**
+ * @brief Transform a string.
+ *
+ * @pre The capacity of `dst` is larger than `transformed_size<>(str)`.
+ */
+template<class Transform, std::size_t N, std::size_t M>
+constexpr void transform_to(const fixed_string_t<N>& str,
+                            fixed_string_t<M>& dst) noexcept
+{
+    dst.size_ = 0;
+    string_sink<M> sink {dst};
+    Transform::apply(str, sink);
+    dst[dst.size_] = '\0';
+}
+
+/**
+ * @brief Convert a type name into a readable C identifier.
+ *
+ * * Identifier characters are kept.
+ * * `::` becomes `__`.
+ * * Spaces and commas separate words by `_`.
+ * * Other characters become words, e.g., `<` becomes `lt`, `*` becomes `ptr`.
+ *
+ * e.g., `ns::vector<int>` becomes `ns__vector_lt_int_gt`.
+ *
+ * The conversion is **not** reversible.
+ */
+struct identifier_transform
+{
+    static constexpr std::string_view word(char c) noexcept
+    {
+        switch (c)
+        {
+        case '<': return "lt";
+        case '>': return "gt";
+        case '*': return "ptr";
+        case '&': return "ref";
+        case '(': return "lp";
+        case ')': return "rp";
+        case '[': return "lb";
+        case ']': return "rb";
+        case ':': return "colon";
+        case '-': return "neg";
+        case '.': return "dot";
+        case '\'': return "q";
+        case '~': return "tilde";
+        default:  return {};
+        }
+    }
+
+    template<std::size_t N, class Sink>
+    static constexpr void apply(const fixed_string_t<N>& str, Sink& sink)
+    {
+        constexpr char hex[] = "0123456789abcdef";
+        // Whether anything has been put.
+        bool started = false;
+        // Whether a separator is required before the next word.
+        bool pending = false;
+        std::size_t pos = 0;
+        while (pos < str.size_)
+        {
+            const char c = str[pos];
+            if (c == ':' && pos + 1 < str.size_ && str[pos + 1] == ':')
+            {
+                sink.put('_');
+                sink.put('_');
+                started = true;
+                pending = false;
+                pos += 2;
+            }
+            else if (iskey(c))
+            {
+                if (pending)
+                {
+                    sink.put('_');
+                }
+                // An identifier cannot start with a digit.
+                else if (!started && '0' <= c && c <= '9')
+                {
+                    sink.put('_');
+                }
+                sink.put(c);
+                started = true;
+                pending = false;
+                ++pos;
+            }
+            else if (c == ' ' || c == ',')
+            {
+                pending = started;
+                ++pos;
+            }
+            else
+            {
+                if (started)
+                {
+                    sink.put('_');
+                }
+                std::string_view w = word(c);
+                if (w.empty())
+                {
+                    const auto u = static_cast<unsigned char>(c);
+                    sink.put('x');
+                    sink.put(hex[u >> 4]);
+                    sink.put(hex[u & 0x0f]);
+                }
+                for (const char d : w)
+                {
+                    sink.put(d);
+                }
+                started = true;
+                pending = true;
+                ++pos;
+            }
+        }
+    }
+};
+
+/**
+ * @brief Encode a type name into a C identifier reversibly.
+ *
+ * * Identifier characters except `_` are kept.
+ * * `_` becomes `__`.
+ * * Other characters become `_` followed by a code letter, e.g.,
+ *   `::` becomes `_n`, `<` becomes `_l`, `, ` becomes `_C`.
+ * * Characters without a code letter become `_x` followed by two
+ *   hexadecimal digits.
+ *
+ * e.g., `ns::vector<int>` becomes `ns_nvector_lint_g`.
+ *
+ * @see `decode_identifier()`.
+ */
+struct encoded_identifier_transform
+{
+    /**
+     * @brief The code letters.
+     *
+     * `::` and `, ` are encoded as single units.
+     */
+    static constexpr std::string_view codes[][2] = {
+        { "::", "n" }, { ", ", "C" },
+        { ":",  "k" }, { " ",  "s" }, { "<",  "l" }, { ">",  "g" },
+        { ",",  "c" }, { "*",  "p" }, { "&",  "r" }, { "(",  "o" },
+        { ")",  "e" }, { "[",  "b" }, { "]",  "d" }, { "'",  "q" },
+        { "-",  "m" }, { ".",  "t" },
+    };
+
+    template<std::size_t N, class Sink>
+    static constexpr void apply(const fixed_string_t<N>& str, Sink& sink)
+    {
+        constexpr char hex[] = "0123456789abcdef";
+        const std::string_view s = str.view();
+        std::size_t pos = 0;
+        while (pos < s.size())
+        {
+            const char c = s[pos];
+            if (c == '_')
+            {
+                sink.put('_');
+                sink.put('_');
+                ++pos;
+                continue;
+            }
+            if (iskey(c))
+            {
+                sink.put(c);
+                ++pos;
+                continue;
+            }
+            bool found = false;
+            for (const auto& code : codes)
+            {
+                if (s.substr(pos, code[0].size()) == code[0])
+                {
+                    sink.put('_');
+                    sink.put(code[1][0]);
+                    pos += code[0].size();
+                    found = true;
+                    break;
+                }
+            }
+            if (!found)
+            {
+                const auto u = static_cast<unsigned char>(c);
+                sink.put('_');
+                sink.put('x');
+                sink.put(hex[u >> 4]);
+                sink.put(hex[u & 0x0f]);
+                ++pos;
+            }
+        }
+    }
+};
+
+/**
+ * @brief Decode an identifier encoded by `encoded_identifier_transform`.
+ *
+ * An ill-formed escape sequence is decoded as `?`.
+ */
+struct decode_identifier_transform
+{
+    static constexpr int hexval(char c) noexcept
+    {
+        return ('0' <= c && c <= '9') ? c - '0' :
+               ('a' <= c && c <= 'f') ? c - 'a' + 10 : -1;
+    }
+
+    template<std::size_t N, class Sink>
+    static constexpr void apply(const fixed_string_t<N>& str, Sink& sink)
+    {
+        using codes = encoded_identifier_transform;
+        std::size_t pos = 0;
+        while (pos < str.size_)
+        {
+            const char c = str[pos];
+            if (c != '_')
+            {
+                sink.put(c);
+                ++pos;
+                continue;
+            }
+            const char e = pos + 1 < str.size_ ? str[pos + 1] : '\0';
+            pos += 2;
+            if (e == '_')
+            {
+                sink.put('_');
+                continue;
+            }
+            if (e == 'x')
+            {
+                const int hi = pos < str.size_ ? hexval(str[pos]) : -1;
+                const int lo = pos + 1 < str.size_ ? hexval(str[pos + 1]) : -1;
+                if (hi >= 0 && lo >= 0)
+                {
+                    sink.put(static_cast<char>(hi * 16 + lo));
+                    pos += 2;
+                }
+                else
+                {
+                    sink.put('?');
+                }
+                continue;
+            }
+            bool found = false;
+            for (const auto& code : codes::codes)
+            {
+                if (code[1][0] == e)
+                {
+                    for (const char d : code[0])
+                    {
+                        sink.put(d);
+                    }
+                    found = true;
+                    break;
+                }
+            }
+            if (!found)
+            {
+                sink.put('?');
+            }
+        }
+    }
+};
+
+/**
+ * @brief The translation unit that is shared by all translation units.
+ *
+ * It names the types that are not local to a translation unit.
+ */
+struct shared_unit
+{
+    static constexpr std::string_view tag {};
+};
+
+/**
+ * @brief The key to look up the translation unit of a type by ADL.
+ *
+ * @see `local_unit()`
+ */
+template<class T>
+struct unit_key {};
+
+/**
+ * @brief Normalize a type name.
+ *
+ * If `NSFX_TYPE_NAME_STABLE_LAMBDA` is `1`:
+ * * `(lambda at file:line:column)` of clang becomes `<lambda>`.
+ *   Likewise, `(unnamed struct at ...)` becomes `<unnamed struct>`, etc.
+ * * `<lambda_hash>` of msvc becomes `<lambda>`, where `hash` consists of
+ *   at least 8 hexadecimal digits.
+ *   The ordinals (e.g., `<lambda_1>`) are kept.
+ * * The names printed by g++ (e.g., `main()::<lambda(int)>`) contain no
+ *   location, thus are kept.
+ *
+ * If `NSFX_TYPE_NAME_LOCAL_SCOPE` is not `0`:
+ * * `{anonymous}::` (g++), `(anonymous namespace)::` (clang) and
+ *   `` `anonymous namespace'::`` (msvc) are replaced by `{anon}::`, or by
+ *   `{tag}::` if `NSFX_TYPE_NAME_LOCAL_SCOPE` is `2`.
+ * * The parameters and qualifiers of enclosing functions are removed, e.g.,
+ *   `f(int) const::X` (g++ and clang) becomes `f()::X`, and
+ *   `` `void f(int)'::`2'::X`` (msvc) becomes `f()::X`.
+ *   Thus, the local classes of overloads may have the same name.
+ *
+ * @tparam Unit It provides `tag` that replaces the anonymous namespaces.
+ */
+template<class Unit>
+struct normalize_transform
+{
+    static constexpr bool enabled = NSFX_TYPE_NAME_STABLE_LAMBDA ||
+                                    NSFX_TYPE_NAME_LOCAL_SCOPE;
+
+    /**
+     * @brief Get the length of a parenthesized location, e.g.,
+     *        `(lambda at file:line:column)`.
+     *
+     * @param[out] what The length of the text before ` at `, e.g., `lambda`.
+     *
+     * @return `0` if there is no location at `pos`.
+     */
+    template<std::size_t N>
+    static constexpr std::size_t location(const fixed_string_t<N>& str,
+                                          std::size_t pos,
+                                          std::size_t& what) noexcept
+    {
+        const std::string_view view = str.view().substr(pos);
+        if (view.substr(0, 8) != "(lambda " &&
+            view.substr(0, 9) != "(unnamed " &&
+            view.substr(0, 11) != "(anonymous ")
+        {
+            return 0;
+        }
+        int depth = 0;
+        for (std::size_t i = 0; i < view.size(); ++i)
+        {
+            if (view[i] == '(')
+            {
+                ++depth;
+            }
+            else if (view[i] == ')' && --depth == 0)
+            {
+                const std::size_t at = view.substr(0, i).find(" at ");
+                if (at == view.npos)
+                {
+                    return 0;
+                }
+                what = at - 1;
+                return i + 1;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Get the length of a hashed lambda name of msvc,
+     *        e.g., `<lambda_8f3e0c1b...>`.
+     *
+     * @return `0` if there is no hashed lambda name at `pos`.
+     */
+    template<std::size_t N>
+    static constexpr std::size_t hashed(const fixed_string_t<N>& str,
+                                        std::size_t pos) noexcept
+    {
+        const std::string_view view = str.view().substr(pos);
+        if (view.substr(0, 8) != "<lambda_")
+        {
+            return 0;
+        }
+        std::size_t i = 8;
+        while (i < view.size() &&
+               (('0' <= view[i] && view[i] <= '9') ||
+                ('a' <= view[i] && view[i] <= 'f')))
+        {
+            ++i;
+        }
+        if (i < 16 || i == view.size() || view[i] != '>')
+        {
+            return 0;
+        }
+        return i + 1;
+    }
+
+    /**
+     * @brief Get the length of an anonymous namespace, including the
+     *        trailing `::`.
+     *
+     * @return `0` if there is no anonymous namespace at `pos`.
+     */
+    template<std::size_t N>
+    static constexpr std::size_t anonymous(const fixed_string_t<N>& str,
+                                           std::size_t pos) noexcept
+    {
+        const std::string_view view = str.view().substr(pos);
+        for (std::string_view a : {std::string_view{"{anonymous}::"},
+                                   std::string_view{"(anonymous namespace)::"},
+                                   std::string_view{"`anonymous namespace'::"}})
+        {
+            if (view.substr(0, a.size()) == a)
+            {
+                return a.size();
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Get the length of the parameters and qualifiers of an enclosing
+     *        function of g++ and clang, e.g., `(int) const` in `f(int) const::X`.
+     *
+     * @return `0` if there are no parameters of an enclosing function at
+     *         `pos`.
+     */
+    template<std::size_t N>
+    static constexpr std::size_t parameters(const fixed_string_t<N>& str,
+                                            std::size_t pos) noexcept
+    {
+        // The parameters follow the name of the function.
+        if (str[pos] != '(' || !pos ||
+            !(iskey(str[pos - 1]) || str[pos - 1] == '>'))
+        {
+            return 0;
+        }
+        const std::string_view view = str.view().substr(pos);
+        int depth = 0;
+        std::size_t i = 0;
+        for (; i < view.size(); ++i)
+        {
+            if (view[i] == '(')
+            {
+                ++depth;
+            }
+            else if (view[i] == ')' && --depth == 0)
+            {
+                break;
+            }
+        }
+        if (i == view.size())
+        {
+            return 0;
+        }
+        ++i;
+        // The qualifiers.
+        while (i < view.size() && view[i] == ' ')
+        {
+            std::size_t k = i + 1;
+            while (k < view.size() && (iskey(view[k]) || view[k] == '&'))
+            {
+                ++k;
+            }
+            const std::string_view q = view.substr(i + 1, k - i - 1);
+            if (q != "const" && q != "volatile" && q != "noexcept" &&
+                q != "&" && q != "&&")
+            {
+                return 0;
+            }
+            i = k;
+        }
+        // It is a function only if a scope follows.
+        if (view.substr(i, 2) != "::")
+        {
+            return 0;
+        }
+        return i;
+    }
+
+    /**
+     * @brief Get the length of an enclosing function of msvc, including the
+     *        trailing block scopes, e.g., `` `void f(int)'::`2'``.
+     *
+     * @param[out] first The offset of the function name.
+     * @param[out] last  The offset past the function name.
+     *
+     * @return `0` if there is no enclosing function at `pos`.
+     */
+    template<std::size_t N>
+    static constexpr std::size_t function(const fixed_string_t<N>& str,
+                                          std::size_t pos,
+                                          std::size_t& first,
+                                          std::size_t& last) noexcept
+    {
+        const std::string_view view = str.view().substr(pos);
+        if (view.empty() || view[0] != '`' || anonymous(str, pos))
+        {
+            return 0;
+        }
+        // The name is followed by the outermost parameters, and is preceded
+        // by the outermost space.
+        int depth = 0;
+        std::size_t i = 1;
+        first = 1;
+        last = 0;
+        for (; i < view.size(); ++i)
+        {
+            const char c = view[i];
+            if (c == '<' || c == '(' || c == '[')
+            {
+                if (c == '(' && depth == 0 && !last)
+                {
+                    last = i;
+                }
+                ++depth;
+            }
+            else if (c == '>' || c == ')' || c == ']')
+            {
+                --depth;
+            }
+            else if (c == ' ' && depth == 0 && !last)
+            {
+                first = i + 1;
+            }
+            else if (c == '\'' && depth == 0)
+            {
+                break;
+            }
+        }
+        if (i == view.size() || !last)
+        {
+            return 0;
+        }
+        ++i;
+        // The block scopes, e.g., ::`2'.
+        while (view.substr(i, 3) == "::`")
+        {
+            std::size_t k = i + 3;
+            while (k < view.size() && '0' <= view[k] && view[k] <= '9')
+            {
+                ++k;
+            }
+            if (k == i + 3 || k == view.size() || view[k] != '\'')
+            {
+                break;
+            }
+            i = k + 1;
+        }
+        return i;
+    }
+
+    template<class Sink>
+    static constexpr void put(Sink& sink, std::string_view str) noexcept
+    {
+        for (const char c : str)
+        {
+            sink.put(c);
+        }
+    }
+
+    template<std::size_t N, class Sink>
+    static constexpr void apply(const fixed_string_t<N>& str, Sink& sink)
+    {
+        std::size_t pos = 0;
+        while (pos < str.size_)
+        {
+            std::size_t n = 0;
+            if (NSFX_TYPE_NAME_STABLE_LAMBDA)
+            {
+                std::size_t what = 0;
+                n = location(str, pos, what);
+                if (n)
+                {
+                    sink.put('<');
+                    put(sink, str.view().substr(pos + 1, what));
+                    sink.put('>');
+                    pos += n;
+                    continue;
+                }
+                n = hashed(str, pos);
+                if (n)
+                {
+                    put(sink, "<lambda>");
+                    pos += n;
+                    continue;
+                }
+            }
+            if (NSFX_TYPE_NAME_LOCAL_SCOPE)
+            {
+                n = anonymous(str, pos);
+                if (n)
+                {
+                    sink.put('{');
+                    put(sink, NSFX_TYPE_NAME_LOCAL_SCOPE == 2 &&
+                              !Unit::tag.empty() ? Unit::tag : "anon");
+                    put(sink, "}::");
+                    pos += n;
+                    continue;
+                }
+                n = parameters(str, pos);
+                if (n)
+                {
+                    put(sink, "()");
+                    pos += n;
+                    continue;
+                }
+                std::size_t first = 0;
+                std::size_t last = 0;
+                n = function(str, pos, first, last);
+                if (n)
+                {
+                    put(sink, str.view().substr(pos + first, last - first));
+                    put(sink, "()");
+                    pos += n;
+                    continue;
+                }
+            }
+            sink.put(str[pos++]);
+        }
+    }
+};
+
+/**
+ * @brief Check whether a type name contains an anonymous namespace.
+ */
+template<std::size_t N>
+constexpr bool has_anonymous(const fixed_string_t<N>& str) noexcept
+{
+    for (std::size_t pos = 0; pos < str.size_; ++pos)
+    {
+        if (normalize_transform<shared_unit>::anonymous(str, pos))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Check whether a type has an explicit name.
+ */
+template<class T, class = void>
+struct has_override_name : std::false_type {};
+
+template<class T>
+struct has_override_name<
+    T, std::void_t<decltype(nsfx::type_name_override<T>::name)>>
+    : std::true_type {};
+
+/**
+ * @brief Check whether a type has an explicit hash.
+ */
+template<class T, class = void>
+struct has_override_hash : std::false_type {};
+
+template<class T>
+struct has_override_hash<
+    T, std::void_t<decltype(nsfx::type_name_override<T>::hash)>>
+    : std::true_type {};
+
+template<class T>
+struct impl;
+
+/**
+ * @brief The type name without keywords, with static storage duration.
+ *
+ * It is not normalized, thus spells the scopes as the compiler does.
+ */
+template<class T>
+inline constexpr auto stripped_name_v = impl<T>::stripped();
+
+/**
+ * @brief The traits of a function type.
+ */
+template<class F>
+struct function_traits
+{
+    static constexpr bool value = false;
+};
+
+template<class... Ts>
+struct types {};
+
+#define NSFX_TYPE_NAME_FUNCTION_TRAITS(CV, REF, NOEXCEPT, C, V, R)          \
+    template<class Ret, class... Args>                                      \
+    struct function_traits<Ret(Args...) CV REF noexcept(NOEXCEPT)>          \
+    {                                                                       \
+        static constexpr bool value = true;                                 \
+        using result = Ret;                                                 \
+        using params = types<Args...>;                                      \
+        static constexpr bool is_const = C;                                 \
+        static constexpr bool is_volatile = V;                              \
+        static constexpr int  ref = R;                                      \
+        static constexpr bool is_noexcept = NOEXCEPT;                       \
+        static constexpr bool is_variadic = false;                          \
+    };                                                                      \
+    template<class Ret, class... Args>                                      \
+    struct function_traits<Ret(Args..., ...) CV REF noexcept(NOEXCEPT)>     \
+    {                                                                       \
+        static constexpr bool value = true;                                 \
+        using result = Ret;                                                 \
+        using params = types<Args...>;                                      \
+        static constexpr bool is_const = C;                                 \
+        static constexpr bool is_volatile = V;                              \
+        static constexpr int  ref = R;                                      \
+        static constexpr bool is_noexcept = NOEXCEPT;                       \
+        static constexpr bool is_variadic = true;                           \
+    }
+
+#define NSFX_TYPE_NAME_FUNCTION_TRAITS_REF(CV, C, V)                        \
+    NSFX_TYPE_NAME_FUNCTION_TRAITS(CV,   , false, C, V, 0);                 \
+    NSFX_TYPE_NAME_FUNCTION_TRAITS(CV,  &, false, C, V, 1);                 \
+    NSFX_TYPE_NAME_FUNCTION_TRAITS(CV, &&, false, C, V, 2);                 \
+    NSFX_TYPE_NAME_FUNCTION_TRAITS(CV,   , true,  C, V, 0);                 \
+    NSFX_TYPE_NAME_FUNCTION_TRAITS(CV,  &, true,  C, V, 1);                 \
+    NSFX_TYPE_NAME_FUNCTION_TRAITS(CV, &&, true,  C, V, 2)
+
+NSFX_TYPE_NAME_FUNCTION_TRAITS_REF(              , false, false);
+NSFX_TYPE_NAME_FUNCTION_TRAITS_REF(const         , true,  false);
+NSFX_TYPE_NAME_FUNCTION_TRAITS_REF(volatile      , false, true );
+NSFX_TYPE_NAME_FUNCTION_TRAITS_REF(const volatile, true,  true );
+
+#undef NSFX_TYPE_NAME_FUNCTION_TRAITS_REF
+#undef NSFX_TYPE_NAME_FUNCTION_TRAITS
+
+/**
+ * @brief The traits of a member pointer type.
+ */
+template<class P>
+struct member_pointer_traits;
+
+template<class M, class C>
+struct member_pointer_traits<M C::*>
+{
+    using member = M;
+    using type = C;
+};
+
+/**
+ * @brief The template arguments of a class template specialization.
+ *
+ * `kind` is
+ * * `0`: not a specialization, or the template parameters are unsupported.
+ * * `1`: `template<class...>`.
+ * * `2`: `template<class, auto>`.
+ * * `3`: `template<auto...>`.
+ */
+template<class U>
+struct template_args_of
+{
+    static constexpr int kind = 0;
+};
+
+template<template<class...> class TT, class... As>
+struct template_args_of<TT<As...>>
+{
+    static constexpr int kind = 1;
+    using args = types<As...>;
+};
+
+template<template<class, auto> class TT, class A, auto V>
+struct template_args_of<TT<A, V>>
+{
+    static constexpr int kind = 2;
+    using arg = A;
+    static constexpr auto value = V;
+};
+
+template<template<auto...> class TT, auto... Vs>
+struct template_args_of<TT<Vs...>>
+{
+    static constexpr int kind = 3;
+    template<class M>
+    static constexpr void apply(M& m) noexcept
+    {
+        (m.template literal<Vs>(), ...);
+    }
+};
+
+#if defined(__SIZEOF_INT128__)
+// `__extension__` keeps `-Wpedantic` quiet about `__int128`.
+__extension__ typedef __int128 int128_t;
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+/**
+ * @brief Get the Itanium C++ ABI code of a builtin type.
+ *
+ * @return An empty string if `U` is not a builtin type.
+ */
+template<class U>
+constexpr std::string_view builtin_code(void) noexcept
+{
+    if constexpr (std::is_same_v<U, void>)               { return "v"; }
+    else if constexpr (std::is_same_v<U, bool>)         { return "b"; }
+    else if constexpr (std::is_same_v<U, char>)          { return "c"; }
+    else if constexpr (std::is_same_v<U, signed char>)   { return "a"; }
+    else if constexpr (std::is_same_v<U, unsigned char>) { return "h"; }
+    else if constexpr (std::is_same_v<U, short>)         { return "s"; }
+    else if constexpr (std::is_same_v<U, unsigned short>){ return "t"; }
+    else if constexpr (std::is_same_v<U, int>)           { return "i"; }
+    else if constexpr (std::is_same_v<U, unsigned int>)  { return "j"; }
+    else if constexpr (std::is_same_v<U, long>)          { return "l"; }
+    else if constexpr (std::is_same_v<U, unsigned long>) { return "m"; }
+    else if constexpr (std::is_same_v<U, long long>)     { return "x"; }
+    else if constexpr (std::is_same_v<U, unsigned long long>) { return "y"; }
+#if defined(__SIZEOF_INT128__)
+    else if constexpr (std::is_same_v<U, int128_t>)      { return "n"; }
+    else if constexpr (std::is_same_v<U, uint128_t>)     { return "o"; }
+#endif
+    else if constexpr (std::is_same_v<U, float>)         { return "f"; }
+    else if constexpr (std::is_same_v<U, double>)        { return "d"; }
+    else if constexpr (std::is_same_v<U, long double>)   { return "e"; }
+    else if constexpr (std::is_same_v<U, wchar_t>)       { return "w"; }
+#if defined(__cpp_char8_t)
+    else if constexpr (std::is_same_v<U, char8_t>)       { return "Du"; }
+#endif
+    else if constexpr (std::is_same_v<U, char16_t>)      { return "Ds"; }
+    else if constexpr (std::is_same_v<U, char32_t>)      { return "Di"; }
+    else if constexpr (std::is_same_v<U, std::nullptr_t>){ return "Dn"; }
+    else                                                 { return {}; }
+}
+
+/**
+ * @brief Mangle types by the Itanium C++ ABI.
+ *
+ * The declarators (cv-qualifiers, pointers, references, arrays,
+ * member pointers and function types) are mangled from the structure of
+ * the types.
+ * The qualified names of classes and enums are parsed from their names,
+ * and the template arguments are mangled from the structure of the types.
+ *
+ * The substitution candidates are identified by their names
+ * (see `stripped_name_v`).
+ *
+ * Unsupported constructs (e.g., local classes, closures, classes nested in
+ * class templates, and template parameters of mixed kinds) produce `?`.
+ *
+ * @tparam Sink     See `counting_sink` and `string_sink`.
+ * @tparam MaxSubs  The maximum number of substitution candidates.
+ */
+template<class Sink, std::size_t MaxSubs>
+struct mangler
+{
+    Sink& sink_;
+    std::string_view subs_[MaxSubs] {};
+    std::size_t num_subs_ = 0;
+
+    constexpr void put(char c) noexcept
+    {
+        sink_.put(c);
+    }
+
+    constexpr void put(std::string_view str) noexcept
+    {
+        for (const char c : str)
+        {
+            sink_.put(c);
+        }
+    }
+
+    template<class I>
+    constexpr void put_number(I n) noexcept
+    {
+        put_decimal(sink_, n);
+    }
+
+    constexpr void put_source_name(std::string_view id) noexcept
+    {
+        if (id == "{anonymous}" || id == "(anonymous namespace)" ||
+            id == "`anonymous namespace'")
+        {
+            id = "_GLOBAL__N_1";
+        }
+        for (const char c : id)
+        {
+            // e.g., local classes and closure types.
+            if (!iskey(c))
+            {
+                put('?');
+                return;
+            }
+        }
+        put_number(id.size());
+        put(id);
+    }
+
+    constexpr bool substitute(std::string_view key) noexcept
+    {
+        for (std::size_t i = 0; i < num_subs_; ++i)
+        {
+            if (subs_[i] == key)
+            {
+                // S_, S0_, S1_, ..., S9_, SA_, ..., SZ_, S10_, ...
+                put('S');
+                if (i)
+                {
+                    constexpr char digits[] =
+                        "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+                    char buf[16] {};
+                    std::size_t k = 0;
+                    std::size_t n = i - 1;
+                    do
+                    {
+                        buf[k++] = digits[n % 36];
+                        n /= 36;
+                    }
+                    while (n);
+                    while (k)
+                    {
+                        put(buf[--k]);
+                    }
+                }
+                put('_');
+                return true;
+            }
+        }
+        return false;
+    }
+
+    constexpr void add(std::string_view key) noexcept
+    {
+        if (num_subs_ < MaxSubs)
+        {
+            subs_[num_subs_++] = key;
+        }
+    }
+
+    template<class U>
+    constexpr void type(void) noexcept
+    {
+        constexpr std::string_view code = builtin_code<U>();
+        if constexpr (!code.empty())
+        {
+            put(code);
+            return;
+        }
+        else
+        {
+            constexpr std::string_view key = stripped_name_v<U>.view();
+            if (substitute(key))
+            {
+                return;
+            }
+            if constexpr (std::is_array_v<U>)
+            {
+                put('A');
+                if constexpr (std::extent_v<U> != 0)
+                {
+                    put_number(std::extent_v<U>);
+                }
+                put('_');
+                type<std::remove_extent_t<U>>();
+            }
+            else if constexpr (std::is_const_v<U> || std::is_volatile_v<U>)
+            {
+                if (std::is_volatile_v<U>)
+                {
+                    put('V');
+                }
+                if (std::is_const_v<U>)
+                {
+                    put('K');
+                }
+                type<std::remove_cv_t<U>>();
+            }
+            else if constexpr (std::is_pointer_v<U>)
+            {
+                put('P');
+                type<std::remove_pointer_t<U>>();
+            }
+            else if constexpr (std::is_lvalue_reference_v<U>)
+            {
+                put('R');
+                type<std::remove_reference_t<U>>();
+            }
+            else if constexpr (std::is_rvalue_reference_v<U>)
+            {
+                put('O');
+                type<std::remove_reference_t<U>>();
+            }
+            else if constexpr (std::is_member_pointer_v<U>)
+            {
+                using traits = member_pointer_traits<U>;
+                put('M');
+                type<typename traits::type>();
+                type<typename traits::member>();
+            }
+            else if constexpr (function_traits<U>::value)
+            {
+                function<U>();
+            }
+            else if constexpr (std::is_class_v<U> || std::is_union_v<U> ||
+                               std::is_enum_v<U>)
+            {
+                // The type is added by `named()`.
+                named<U>();
+                return;
+            }
+            else
+            {
+                put('?');
+            }
+            add(key);
+        }
+    }
+
+    template<class U>
+    constexpr void function(void) noexcept
+    {
+        using traits = function_traits<U>;
+        if (traits::is_volatile)
+        {
+            put('V');
+        }
+        if (traits::is_const)
+        {
+            put('K');
+        }
+        if (traits::is_noexcept)
+        {
+            put("Do");
+        }
+        put('F');
+        type<typename traits::result>();
+        params(typename traits::params{});
+        if (traits::is_variadic)
+        {
+            put('z');
+        }
+        else if constexpr (std::is_same_v<typename traits::params, types<>>)
+        {
+            put('v');
+        }
+        if (traits::ref == 1)
+        {
+            put('R');
+        }
+        else if (traits::ref == 2)
+        {
+            put('O');
+        }
+        put('E');
+    }
+
+    template<class... Args>
+    constexpr void params(types<Args...>) noexcept
+    {
+        (type<Args>(), ...);
+    }
+
+    template<auto V>
+    constexpr void literal(void) noexcept
+    {
+        using V_t = std::remove_cv_t<decltype(V)>;
+        if constexpr (std::is_same_v<V_t, bool>)
+        {
+            put(V ? "Lb1E" : "Lb0E");
+        }
+        else if constexpr (std::is_integral_v<V_t> || std::is_enum_v<V_t>)
+        {
+            using I = std::conditional_t<std::is_enum_v<V_t>,
+                                         std::underlying_type<V_t>,
+                                         std::common_type<V_t>>;
+            using U_t = std::make_unsigned_t<typename I::type>;
+            const auto v = static_cast<typename I::type>(V);
+            put('L');
+            type<V_t>();
+            if (v < 0)
+            {
+                put('n');
+                put_number(static_cast<U_t>(U_t{0} - static_cast<U_t>(v)));
+            }
+            else
+            {
+                put_number(static_cast<U_t>(v));
+            }
+            put('E');
+        }
+        else
+        {
+            put('?');
+        }
+    }
+
+    /**
+     * @brief Mangle a class, union or enum type by its name.
+     */
+    template<class U>
+    constexpr void named(void) noexcept
+    {
+        constexpr std::string_view name = stripped_name_v<U>.view();
+        // The positions of the components.
+        constexpr std::size_t max_comps = 32;
+        std::size_t starts[max_comps] {};
+        std::size_t ends[max_comps] {};
+        std::size_t n = 0;
+        // The position of the template argument list.
+        std::size_t tmpl = name.npos;
+        int depth = 0;
+        starts[0] = 0;
+        for (std::size_t pos = 0; pos < name.size(); ++pos)
+        {
+            const char c = name[pos];
+            if (c == '(' || c == '[')
+            {
+                ++depth;
+            }
+            else if (c == ')' || c == ']')
+            {
+                --depth;
+            }
+            else if (c == '<' && depth == 0)
+            {
+                tmpl = pos;
+                break;
+            }
+            else if (c == ':' && depth == 0 && pos + 1 < name.size() &&
+                     name[pos + 1] == ':' && n + 1 < max_comps)
+            {
+                ends[n++] = pos;
+                starts[n] = pos + 2;
+                ++pos;
+            }
+        }
+        ends[n++] = tmpl == name.npos ? name.size() : tmpl;
+        const std::string_view qual = name.substr(0, ends[n - 1]);
+        auto comp = [&](std::size_t i) {
+            return name.substr(starts[i], ends[i] - starts[i]);
+        };
+        auto prefix = [&](std::size_t i) {
+            return name.substr(0, ends[i]);
+        };
+        ////////////////////
+        // std::basic_string<char>, std::istream, std::ostream, std::iostream
+        if constexpr (std::is_same_v<U, std::basic_string<char>>)
+        {
+            if (qual == "std::basic_string")
+            {
+                put("Ss");
+                return;
+            }
+        }
+        if constexpr (std::is_same_v<U, std::basic_istream<char>>)
+        {
+            if (qual == "std::basic_istream")
+            {
+                put("Si");
+                return;
+            }
+        }
+        if constexpr (std::is_same_v<U, std::basic_ostream<char>>)
+        {
+            if (qual == "std::basic_ostream")
+            {
+                put("So");
+                return;
+            }
+        }
+        if constexpr (std::is_same_v<U, std::basic_iostream<char>>)
+        {
+            if (qual == "std::basic_iostream")
+            {
+                put("Sd");
+                return;
+            }
+        }
+        ////////////////////
+        const bool is_std = n > 1 && comp(0) == "std";
+        const std::size_t first = is_std ? 1 : 0;
+        const bool nested = n - first >= 2;
+        // The prefixes are the enclosing scopes, and the template name.
+        const std::size_t num_prefixes = tmpl != name.npos ? n : n - 1;
+        if (nested)
+        {
+            put('N');
+        }
+        // Substitute the longest prefix.
+        std::size_t start = first;
+        for (std::size_t i = num_prefixes; i-- > first;)
+        {
+            if (substitute(prefix(i)))
+            {
+                start = i + 1;
+                break;
+            }
+        }
+        if (start == first && is_std)
+        {
+            if (!nested && tmpl != name.npos && comp(1) == "allocator")
+            {
+                put("Sa");
+                start = n;
+            }
+            else if (!nested && tmpl != name.npos &&
+                     comp(1) == "basic_string")
+            {
+                put("Sb");
+                start = n;
+            }
+            else
+            {
+                put("St");
+            }
+        }
+        for (std::size_t i = start; i < n; ++i)
+        {
+            put_source_name(comp(i));
+            if (i < num_prefixes)
+            {
+                add(prefix(i));
+            }
+        }
+        if (tmpl != name.npos)
+        {
+            put('I');
+            using args = template_args_of<U>;
+            if constexpr (args::kind == 1)
+            {
+                params(typename args::args{});
+            }
+            else if constexpr (args::kind == 2)
+            {
+                type<typename args::arg>();
+                literal<args::value>();
+            }
+            else if constexpr (args::kind == 3)
+            {
+                args::apply(*this);
+            }
+            else
+            {
+                put('?');
+            }
+            put('E');
+        }
+        if (nested)
+        {
+            put('E');
+        }
+        add(name);
+    }
+};
+
+/**
+ * @brief Get the length of the mangled name of a type.
+ */
+template<class U>
+constexpr std::size_t mangled_size(void) noexcept
+{
+    constexpr std::size_t M = 2 * stripped_name_v<U>.size_ + 16;
+    counting_sink sink;
+    mangler<counting_sink, M> m {sink};
+    m.template type<U>();
+    return sink.size_;
+}
+
+/**
+ * @brief Get the raw type name of a type.
+ */
+template<class T>
+struct impl
+{
+    /**
+     * @brief Get the raw type name.
+     *
+     * @return The returned `fixed_string_t<>` is zero-terminated.
+     */
+    static constexpr auto raw(void)
+    {
+        // `full` is zero-terminated.
+        constexpr auto full = to_fixed_string(NSFX_FUNCTION);
+        // Extract type name from `full`.
+        constexpr name_range r = locate(full.view(), "[with T = ", "[T = ",
+                                        "impl<", ">::raw(");
+        // `name` is zero-terminated.
+        return fixed_string_t<r.size_+1>{full.data_ + r.pos_, r.size_};
+    }
+
+    /**
+     * @brief Get the size of tidy type name.
+     *
+     * The keywords `enum`, `class`, `struct` and `__cdecl` are removed from
+     * the type name.
+     *
+     * @return The returned `fixed_string_t<>` is zero-terminated.
+     */
+    static constexpr std::size_t dry(void) noexcept
+    {
+        auto name = raw();
+#if defined(__clang__) || defined(__GNUC__)
+        return name.capacity_;
+#elif defined(_MSC_VER)
+        constexpr std::size_t len = name.capacity_ - 1;
+        std::size_t size = 0;
+        std::size_t pos = 0;
+        while (true)
+        {
+            // The number of characters to remove.
+            std::size_t n = 0;
+            n = match(name, pos, len, "enum");
+            if (n) { pos += n; continue; }
+            n = match(name, pos, len, "class");
+            if (n) { pos += n; continue; }
+            n = match(name, pos, len, "struct");
+            if (n) { pos += n; continue; }
+            n = match(name, pos, len, "__cdecl");
+            if (n) { pos += n; continue; }
+            // The character before `sub` is not an identifier character.
+            while (pos < len && iskey(name[pos]))
+            {
+                ++size;
+                ++pos;
+            }
+            // The character before `sub` is not an identifier character.
+            while (pos < len && !iskey(name[pos]))
+            {
+                ++size;
+                ++pos;
+            }
+            // The current character is a non-identifier character.
+            if (pos == len)
+            {
+                break;
+            }
+        }
+        // Strip trailing spaces.
+        while (pos && name[pos - 1] == ' ')
+        {
+            --pos;
+            --size;
+        }
+        return size;
+#else
+# error Unsupported compiler.
+#endif
+    }
+
+    /**
+     * @brief Get the type name without keywords.
+     *
+     * The keywords `enum`, `class`, `struct` and `__cdecl` are removed from
+     * the type name.
+     *
+     * @return The returned `fixed_string_t<>` is zero-terminated.
+     */
+    static constexpr auto stripped(void) noexcept
+    {
+        auto name = raw();
+#if defined(__clang__) || defined(__GNUC__)
+        return name;
+#elif defined(_MSC_VER)
+        constexpr std::size_t len = name.capacity_ - 1;
+        constexpr std::size_t L = dry();
+        fixed_string_t<L+1> dst {};
+        std::size_t pos = 0;
+        while (true)
+        {
+            // The number of characters to remove.
+            std::size_t n = 0;
+            n = match(name, pos, len, "enum");
+            if (n) { pos += n; continue; }
+            n = match(name, pos, len, "class");
+            if (n) { pos += n; continue; }
+            n = match(name, pos, len, "struct");
+            if (n) { pos += n; continue; }
+            n = match(name, pos, len, "__cdecl");
+            if (n) { pos += n; continue; }
+            // The character before `sub` is not an identifier character.
+            while (dst.size_ < L && pos < len && iskey(name[pos]))
+            {
+                dst[dst.size_++] = name[pos++];
+            }
+            // The character before `sub` is not an identifier character.
+            while (dst.size_ < L && pos < len && !iskey(name[pos]))
+            {
+                dst[dst.size_++] = name[pos++];
+            }
+            // The current character is a non-identifier character.
+            if (dst.size_ == L || pos == len)
+            {
+                break;
+            }
+        }
+        dst[L] = '\0';
+        return dst;
+#else
+# error Unsupported compiler.
+#endif
+    }
+
+    /**
+     * @brief Get the tidy type name.
+     *
+     * It is the explicit name if `type_name_override<T>` provides one.
+     * Otherwise, the keywords are removed (see `stripped()`), and the name is
+     * normalized (see `normalize_transform`).
+     *
+     * @return The returned `fixed_string_t<>` is zero-terminated.
+     */
+    static constexpr auto tidy(void) noexcept
+    {
+        if constexpr (has_override_name<T>::value)
+        {
+            constexpr std::string_view name = nsfx::type_name_override<T>::name;
+            return fixed_string_t<name.size()+1>{name.data(), name.size()};
+        }
+        else
+        {
+            return normalized();
+        }
+    }
+
+    /**
+     * @brief Get the normalized type name.
+     *
+     * @return The returned `fixed_string_t<>` is zero-terminated.
+     */
+    static constexpr auto normalized(void) noexcept
+    {
+        constexpr auto name = stripped();
+        if constexpr (!normalize_transform<shared_unit>::enabled)
+        {
+            return name;
+        }
+        else if constexpr (NSFX_TYPE_NAME_LOCAL_SCOPE == 2 &&
+                           has_anonymous(name))
+        {
+            // The type is local to the translation unit, and so is
+            // `impl<T>`.
+            // `local_unit()` is a dependent name that is only looked up here.
+            return normalized_in<decltype(local_unit(unit_key<T>{}))>();
+        }
+        else
+        {
+            return normalized_in<shared_unit>();
+        }
+    }
+
+    /**
+     * @brief Get the normalized type name, where the anonymous namespaces are
+     *        named by `Unit`.
+     */
+    template<class Unit>
+    static constexpr auto normalized_in(void) noexcept
+    {
+        using normalize = normalize_transform<Unit>;
+        constexpr auto name = stripped();
+        constexpr std::size_t L = transformed_size<normalize>(name);
+        fixed_string_t<L+1> dst {};
+        transform_to<normalize>(name, dst);
+        return dst;
+    }
+
+    /**
+     * @brief Get the tidy type name in another encoding.
+     *
+     * @tparam CharT The character type of the encoding.
+     *
+     * @return The returned `basic_fixed_string<>` is zero-terminated.
+     */
+    template<class CharT>
+    static constexpr auto encode(void) noexcept
+    {
+        constexpr auto name = tidy();
+        constexpr std::size_t L = transcoded_size<CharT>(name);
+        basic_fixed_string<CharT, L+1> dst {};
+        transcode(name, dst);
+        return dst;
+    }
+
+    /**
+     * @brief Transform the tidy type name.
+     *
+     * @tparam Transform See `transformed_size()`.
+     *
+     * @return The returned `fixed_string_t<>` is zero-terminated.
+     */
+    template<class Transform>
+    static constexpr auto transform(void) noexcept
+    {
+        constexpr auto name = tidy();
+        constexpr std::size_t L = transformed_size<Transform>(name);
+        fixed_string_t<L+1> dst {};
+        transform_to<Transform>(name, dst);
+        return dst;
+    }
+
+    /**
+     * @brief Write the versioned type name.
+     */
+    template<std::uint32_t Version, class Sink>
+    static constexpr void write_versioned(Sink& sink) noexcept
+    {
+        constexpr auto name = tidy();
+        for (std::size_t i = 0; i < name.size_; ++i)
+        {
+            sink.put(name[i]);
+        }
+        sink.put('@');
+        put_decimal(sink, Version);
+    }
+
+    /**
+     * @brief Get the versioned type name.
+     *
+     * @return The returned `fixed_string_t<>` is zero-terminated.
+     */
+    template<std::uint32_t Version>
+    static constexpr auto versioned(void) noexcept
+    {
+        if constexpr (Version == 0)
+        {
+            return tidy();
+        }
+        else
+        {
+            constexpr std::size_t L = [] {
+                counting_sink sink;
+                write_versioned<Version>(sink);
+                return sink.size_;
+            }();
+            fixed_string_t<L+1> dst {};
+            string_sink<L+1> sink {dst};
+            write_versioned<Version>(sink);
+            dst[dst.size_] = '\0';
+            return dst;
+        }
+    }
+
+    /**
+     * @brief Get the Itanium C++ ABI mangled type name.
+     *
+     * @return The returned `fixed_string_t<>` is zero-terminated.
+     */
+    static constexpr auto mangled(void) noexcept
+    {
+        constexpr std::size_t L = mangled_size<T>();
+        constexpr std::size_t M = 2 * stripped_name_v<T>.size_ + 16;
+        fixed_string_t<L+1> dst {};
+        string_sink<L+1> sink {dst};
+        mangler<string_sink<L+1>, M> m {sink};
+        m.template type<T>();
+        dst[dst.size_] = '\0';
+        return dst;
+    }
+
+    /**
+     * @brief Get the unqualified type name.
+     *
+     * @pre The type **must** be a value type.
+     *
+     * @return The returned `fixed_string_t<>` is zero-terminated.
+     */
+    static constexpr auto base(void) noexcept
+    {
+        if constexpr (std::is_const_v<T>     ||
+                      std::is_volatile_v<T>  ||
+                      std::is_array_v<T>     ||
+                      std::is_pointer_v<T>   ||
+                      std::is_reference_v<T> ||
+                      // T is not a function type, possibly qualified.
+                      // e.g., int (float)
+                      // e.g., int (float) const & noexcept
+                      std::is_function_v<T>  ||
+                      // T is not a member object pointer.
+                      // e.g., int (C::*)
+                      // T is not a member function pointer.
+                      // e.g., int (C::*)(float)
+                      std::is_member_pointer_v<T>)
+        {
+            return tidy();
+        }
+        else
+        {
+            constexpr auto name = tidy();
+            // Find the last top-level "::".
+            constexpr std::size_t pos = unqualified_pos(name.view());
+            if constexpr (pos == 0)
             {
                 return name;
             }
             else
             {
-                constexpr std::size_t N = name.capacity_ - pos - 1;
-                return fixed_string_t<N>{name.data_ + pos + 1, N};
+                constexpr std::size_t N = name.capacity_ - pos;
+                return fixed_string_t<N>{name.data_ + pos, N};
             }
         }
     }
 };
 
+// The translation unit is declared after `impl<T>`, so the definition of
+// `impl<T>` does not refer to it.
+// It is only found by ADL when `impl<T>` is instantiated for a type in an
+// anonymous namespace, which is local to the translation unit, too.
+// Thus, the definitions of `impl<T>` are the same in all translation units.
+inline namespace {
+
+/**
+ * @brief The current translation unit.
+ */
+struct translation_unit
+{
+#if defined(NSFX_TYPE_NAME_TU_TAG)
+    static constexpr std::string_view path {NSFX_TYPE_NAME_TU_TAG};
+    // The file name without directories.
+    static constexpr std::string_view tag =
+        path.substr(path.find_last_of("/\\") == path.npos
+                    ? 0 : path.find_last_of("/\\") + 1);
+#else
+    static constexpr std::string_view tag {};
+#endif
+};
+
+/**
+ * @brief Get the translation unit of a type that is local to it.
+ *
+ * It is only used in unevaluated operands.
+ */
+template<class T>
+translation_unit local_unit(unit_key<T>) noexcept;
+
+} // unnamed namespace
+
+/**
+ * @brief The name of a value.
+ *
+ * @tparam V A non-type template argument.
+ */
+template<auto V>
+struct impl_value
+{
+    /**
+     * @brief Get the value name as printed by the compiler.
+     *
+     * @return The returned `fixed_string_t<>` is zero-terminated.
+     */
+    static constexpr auto raw(void)
+    {
+        // `full` is zero-terminated.
+        constexpr auto full = to_fixed_string(NSFX_FUNCTION);
+        // Extract value name from `full`.
+        constexpr name_range r = locate(full.view(), "[with auto V = ",
+                                        "[V = ", "impl_value<", ">::raw(");
+        // `name` is zero-terminated.
+        return fixed_string_t<r.size_+1>{full.data_ + r.pos_, r.size_};
+    }
+
+    /**
+     * @brief Write the tidy value name.
+     *
+     * Integers are written in decimal, since some compilers print them in
+     * hexadecimal (e.g., MSVC).
+     * The address `(& x)` printed by g++ is written as `&x`.
+     */
+    template<class Sink>
+    static constexpr void write(Sink& sink) noexcept
+    {
+        using V_t = std::remove_cv_t<decltype(V)>;
+        if constexpr (std::is_integral_v<V_t>        &&
+                      !std::is_same_v<V_t, bool>     &&
+                      !std::is_same_v<V_t, char>     &&
+                      !std::is_same_v<V_t, wchar_t>  &&
+                      !std::is_same_v<V_t, char16_t> &&
+                      !std::is_same_v<V_t, char32_t>)
+        {
+            using U_t = std::make_unsigned_t<V_t>;
+            if constexpr (std::is_signed_v<V_t>)
+            {
+                if (V < 0)
+                {
+                    sink.put('-');
+                    put_decimal(sink, static_cast<U_t>(
+                        U_t{0} - static_cast<U_t>(V)));
+                    return;
+                }
+            }
+            put_decimal(sink, static_cast<U_t>(V));
+        }
+        else
+        {
+            constexpr auto name = raw();
+            std::string_view view = name.view();
+            if (view.size() > 3 && view.substr(0, 3) == "(& " &&
+                view.back() == ')')
+            {
+                sink.put('&');
+                view = view.substr(3, view.size() - 4);
+            }
+            for (const char c : view)
+            {
+                sink.put(c);
+            }
+        }
+    }
+
+    /**
+     * @brief Get the tidy value name.
+     *
+     * @return The returned `fixed_string_t<>` is zero-terminated.
+     */
+    static constexpr auto name(void) noexcept
+    {
+        constexpr std::size_t L = [] {
+            counting_sink sink;
+            write(sink);
+            return sink.size_;
+        }();
+        fixed_string_t<L+1> dst {};
+        string_sink<L+1> sink {dst};
+        write(sink);
+        dst[dst.size_] = '\0';
+        return dst;
+    }
+};
 
 } // namespace type_name
 } // namespace details
@@ -493,11 +2569,405 @@ struct type_name
         return details::type_name::impl<T>::base();
     }
 
+    /**
+     * @brief Get the hash of the type name.
+     *
+     * It is the 64-bit FNV-1a hash of `name()`, unless an explicit hash is
+     * provided by `type_name_override<T>`.
+     * Since the compilers spell some types differently, the hash is only
+     * stable for the same compiler family, unless the name is explicit.
+     */
+    static constexpr std::uint64_t hash(void) noexcept
+    {
+        if constexpr (details::type_name::has_override_hash<T>::value)
+        {
+            return type_name_override<T>::hash;
+        }
+        else
+        {
+            return details::type_name::fnv1a(type_name_v<T>.view());
+        }
+    }
+
+    /**
+     * @brief Get the versioned type name.
+     *
+     * It is `name()` followed by `@` and the version, e.g., `ns::record@2`.
+     * Version `0` is the unversioned `name()`.
+     *
+     * @tparam Version The version, `type_version_v<T>` by default.
+     *                 Specify an older version to obtain the old name.
+     *
+     * @return The returned `fixed_string_t<>` is zero-terminated.
+     */
+    template<std::uint32_t Version = type_version_v<T>>
+    static constexpr auto versioned(void) noexcept
+    {
+        return details::type_name::impl<T>::template versioned<Version>();
+    }
+
+    /**
+     * @brief Get the hash of the versioned type name.
+     *
+     * It is the 64-bit FNV-1a hash of `versioned<Version>()`.
+     * If an explicit hash is provided by `type_name_override<T>`, it is
+     * continued by the suffix of the version instead, e.g., `@2`, so the
+     * types with the same explicit name but different explicit hashes have
+     * different versioned hashes.
+     * The hash of version `0` is `hash()`, thus types keyed by `hash()` can
+     * adopt versions without rewriting their data.
+     *
+     * @tparam Version The version, `type_version_v<T>` by default.
+     */
+    template<std::uint32_t Version = type_version_v<T>>
+    static constexpr std::uint64_t versioned_hash(void) noexcept
+    {
+        if constexpr (Version == 0)
+        {
+            return hash();
+        }
+        else if constexpr (details::type_name::has_override_hash<T>::value)
+        {
+            constexpr auto name = versioned<Version>();
+            return details::type_name::fnv1a(
+                name.view().substr(name.view().rfind('@')), hash());
+        }
+        else
+        {
+            constexpr auto name = versioned<Version>();
+            return details::type_name::fnv1a(name.view());
+        }
+    }
+
+    /**
+     * @brief Get the type name as a readable C identifier.
+     *
+     * e.g., `ns::vector<int>` becomes `ns__vector_lt_int_gt`.
+     * It is suitable for symbol names, metric names and file names,
+     * but it is **not** reversible.
+     *
+     * @return The returned `fixed_string_t<>` is zero-terminated.
+     */
+    static constexpr auto identifier(void) noexcept
+    {
+        return details::type_name::impl<T>::template transform<
+            details::type_name::identifier_transform>();
+    }
+
+    /**
+     * @brief Get the type name encoded as a C identifier reversibly.
+     *
+     * e.g., `ns::vector<int>` becomes `ns_nvector_lint_g`.
+     *
+     * @return The returned `fixed_string_t<>` is zero-terminated.
+     *
+     * @see `decode_identifier()`.
+     */
+    static constexpr auto encoded_identifier(void) noexcept
+    {
+        return details::type_name::impl<T>::template transform<
+            details::type_name::encoded_identifier_transform>();
+    }
+
+    /**
+     * @brief Get the Itanium C++ ABI mangled type name.
+     *
+     * e.g., `const ns::C*` becomes `PKN2ns1CE`.
+     * On GCC and Clang, `mangled()` of a type without cv-qualifiers or
+     * references equals `typeid(T).name()`.
+     *
+     * @return The returned `fixed_string_t<>` is zero-terminated.
+     */
+    static constexpr auto mangled(void) noexcept
+    {
+        return details::type_name::impl<T>::mangled();
+    }
+
+    /**
+     * @brief Get the UTF-8 encoded type name.
+     *
+     * Before C++20, the character type is `char`.
+     *
+     * @return The returned `basic_fixed_string<>` is zero-terminated.
+     */
+    static constexpr auto u8name(void) noexcept
+    {
+#if defined(__cpp_char8_t)
+        return details::type_name::impl<T>::template encode<char8_t>();
+#else
+        return details::type_name::impl<T>::template encode<char>();
+#endif
+    }
+
+    /**
+     * @brief Get the wide type name.
+     *
+     * It is UTF-16 encoded on Windows, and UTF-32 encoded elsewhere.
+     *
+     * @return The returned `basic_fixed_string<>` is zero-terminated.
+     */
+    static constexpr auto wname(void) noexcept
+    {
+        return details::type_name::impl<T>::template encode<wchar_t>();
+    }
+
+    /**
+     * @brief Get the UTF-16 encoded type name.
+     *
+     * @return The returned `basic_fixed_string<>` is zero-terminated.
+     */
+    static constexpr auto u16name(void) noexcept
+    {
+        return details::type_name::impl<T>::template encode<char16_t>();
+    }
+
 };
 
 
+/**
+ * @brief The unqualified type name with static storage duration.
+ */
+template<class T>
+inline constexpr auto type_base_v = type_name<T>::base();
+
+/**
+ * @brief Get the name of a value.
+ *
+ * `V` can be a value of an integral, enum, pointer, member pointer or
+ * (since C++20) class type that is usable as a non-type template argument.
+ *
+ * e.g., `ns::red` for an enumerator, `-3` for an integer, and `&ns::x` for
+ * the address of a variable.
+ *
+ * The integers are in decimal.
+ * The other values are spelled by the compiler, thus may differ among
+ * compilers.
+ *
+ * @return The returned `fixed_string_t<>` is zero-terminated.
+ */
+template<auto V>
+constexpr auto value_name(void) noexcept
+{
+    return details::type_name::impl_value<V>::name();
+}
+
+/**
+ * @brief The value name with static storage duration.
+ *
+ * A `std::string_view` that refers to it is a constant expression.
+ */
+template<auto V>
+inline constexpr auto value_name_v = value_name<V>();
+
+/**
+ * @brief The top-level template arguments of a type.
+ *
+ * It is a `std::array<std::string_view, N>` that refers to `type_name_v<T>`.
+ * It is empty if `T` is not a template specialization.
+ *
+ * e.g., the arguments of `std::map<int, ns::C>` are `int` and `ns::C`.
+ *
+ * @remarks The default template arguments are printed by some compilers
+ *          (e.g., MSVC), but omitted by others (e.g., GCC and Clang).
+ */
+template<class T>
+inline constexpr auto template_args_v =
+    details::type_name::template_args<T>();
+
+/**
+ * @brief Get the top-level template arguments of a type.
+ *
+ * @see `template_args_v`
+ */
+template<class T>
+constexpr const auto& template_args(void) noexcept
+{
+    return template_args_v<T>;
+}
+
+/**
+ * @brief Decode an identifier from `type_name<T>::encoded_identifier()`.
+ *
+ * The decoded string is never longer than the encoded string.
+ *
+ * @return The returned `fixed_string_t<>` is zero-terminated.
+ */
 template<std::size_t N>
-std::ostream& operator<<(std::ostream& os, const fixed_string_t<N>& s)
+constexpr fixed_string_t<N> decode_identifier(const fixed_string_t<N>& str)
+    noexcept
+{
+    fixed_string_t<N> dst {};
+    details::type_name::transform_to<
+        details::type_name::decode_identifier_transform>(str, dst);
+    return dst;
+}
+
+
+namespace details {
+namespace type_name {
+
+/**
+ * @brief The function object type that is named by a tag.
+ */
+template<class Tag>
+struct tag_owner
+{
+    /**
+     * @brief Claim the tag for a function object type.
+     *
+     * @param[in] key The address that identifies the function object type.
+     *
+     * @return `false` if the tag has been claimed for another type.
+     */
+    static bool claim(const void* key) noexcept
+    {
+        static std::atomic<const void*> owner {nullptr};
+        const void* expected = nullptr;
+        const bool ok = owner.compare_exchange_strong(expected, key) ||
+                        expected == key;
+        assert(ok && "Function objects of different types have the same tag.");
+        return ok;
+    }
+};
+
+/**
+ * @brief Whether `Tag` names `F` alone.
+ *
+ * It is instantiated by `tagged<Tag, F>`, and claims the tag during the
+ * dynamic initialization.
+ */
+template<class Tag, class F>
+inline const bool tag_claimed =
+    tag_owner<Tag>::claim(&tag_claimed<Tag, F>);
+
+} // namespace type_name
+} // namespace details
+
+
+/**
+ * @brief A function object that is named by a tag.
+ *
+ * The closure types of lambdas have no portable names.
+ * Wrap a lambda to give it a stable name, e.g., in dispatch tables keyed by
+ * `type_name<>`.
+ * The name is `nsfx::tagged<Tag>`, which does not depend on `F`, thus is
+ * stable in every naming mode.
+ *
+ * A tag names a single function object type.
+ * Function objects of different types with the same tag would have the same
+ * name and the same hash, thus such tags are rejected by an `assert()` during
+ * the dynamic initialization, i.e., before `main()` in practice.
+ *
+ * @code
+ * struct on_connect;
+ * auto f = nsfx::make_tagged<on_connect>([] (int) { ... });
+ * nsfx::type_name<decltype(f)>::name(); // nsfx::tagged<on_connect>
+ * @endcode
+ *
+ * @tparam Tag The tag type that names the function object.
+ * @tparam F   The type of the function object, e.g., a closure type or
+ *             a function pointer type.
+ */
+template<class Tag, class F>
+class tagged
+{
+public:
+    using tag_type = Tag;
+    using function_type = F;
+
+    constexpr explicit tagged(F f) noexcept(
+        std::is_nothrow_move_constructible_v<F>)
+        : f_(std::move(f))
+    {
+        // Claim the tag.
+        (void)&details::type_name::tag_claimed<Tag, F>;
+    }
+
+    template<class... Args>
+    constexpr decltype(auto) operator()(Args&&... args) noexcept(
+        std::is_nothrow_invocable_v<F&, Args&&...>)
+    {
+        return f_(std::forward<Args>(args)...);
+    }
+
+    template<class... Args>
+    constexpr decltype(auto) operator()(Args&&... args) const noexcept(
+        std::is_nothrow_invocable_v<const F&, Args&&...>)
+    {
+        return f_(std::forward<Args>(args)...);
+    }
+
+    constexpr const F& function(void) const noexcept
+    {
+        return f_;
+    }
+
+private:
+    F f_;
+};
+
+/**
+ * @brief Make a function object that is named by a tag.
+ *
+ * @see `tagged<Tag, F>`
+ */
+template<class Tag, class F>
+constexpr tagged<Tag, std::decay_t<F>> make_tagged(F&& f)
+{
+    return tagged<Tag, std::decay_t<F>>{std::forward<F>(f)};
+}
+
+namespace details {
+namespace type_name {
+
+/**
+ * @brief Get the name of `tagged<Tag, F>`.
+ *
+ * @return The returned `fixed_string_t<>` is zero-terminated.
+ */
+template<class Tag>
+constexpr auto tagged_name(void) noexcept
+{
+    constexpr std::string_view prefix = "nsfx::tagged<";
+    constexpr auto& tag = nsfx::type_name_v<Tag>;
+    fixed_string_t<prefix.size() + tag.size_ + 2> dst {};
+    string_sink<prefix.size() + tag.size_ + 2> sink {dst};
+    for (const char c : prefix)
+    {
+        sink.put(c);
+    }
+    for (std::size_t i = 0; i < tag.size_; ++i)
+    {
+        sink.put(tag[i]);
+    }
+    sink.put('>');
+    dst[dst.size_] = '\0';
+    return dst;
+}
+
+template<class Tag>
+inline constexpr auto tagged_name_v = tagged_name<Tag>();
+
+} // namespace type_name
+} // namespace details
+
+/**
+ * @brief Name `tagged<Tag, F>` by its tag alone.
+ *
+ * The tag is claimed for `F` (see `tagged<Tag, F>`).
+ */
+template<class Tag, class F>
+struct type_name_override<tagged<Tag, F>>
+{
+    static constexpr std::string_view name =
+        ((void)&details::type_name::tag_claimed<Tag, F>,
+         details::type_name::tagged_name_v<Tag>.view());
+};
+
+template<class CharT, class Traits, std::size_t N>
+std::basic_ostream<CharT, Traits>&
+operator<<(std::basic_ostream<CharT, Traits>& os,
+           const basic_fixed_string<CharT, N>& s)
 {
     return os << s.view();
 }
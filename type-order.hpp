@@ -0,0 +1,203 @@
+/**
+ * @file
+ *
+ * @brief Type ordering at compile time.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#ifndef TYPE_ORDER_HPP__4B0C3E2A_7D1F_4C55_9B8E_2F6A1D3C5E70
+#define TYPE_ORDER_HPP__4B0C3E2A_7D1F_4C55_9B8E_2F6A1D3C5E70
+
+#include "type-name.hpp"
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace nsfx {
+
+/**
+ * @brief A list of types.
+ */
+template<class... Ts>
+struct type_list
+{
+    static constexpr std::size_t size = sizeof...(Ts);
+};
+
+/**
+ * @brief Compare two types by their names.
+ *
+ * @return
+ *   A negative value if the name of `A` is lexicographically less than
+ *   the name of `B`.\n
+ *   `0` if the names are the same.\n
+ *   Otherwise, a positive value.
+ */
+template<class A, class B>
+constexpr int type_compare(void) noexcept
+{
+    return type_name_v<A>.view().compare(type_name_v<B>.view());
+}
+
+/**
+ * @brief A total order over types based on their names.
+ *
+ * @remark
+ *   The order is total as long as distinct types have distinct names.
+ *   Types whose names are not unique (e.g., lambdas declared within the same
+ *   function on some compilers, or types in anonymous namespaces of different
+ *   translation units) are *equivalent*.
+ */
+template<class A, class B>
+struct type_less : std::bool_constant<(type_compare<A, B>() < 0)> {};
+
+template<class A, class B>
+inline constexpr bool type_less_v = type_less<A, B>::value;
+
+
+namespace details {
+namespace type_order {
+
+/**
+ * @brief Get the sorted order of the types.
+ *
+ * The sort is stable, i.e., equivalent types retain their relative order.
+ *
+ * @return `order[k]` is the index of the `k`-th type in the sorted order.
+ */
+template<class... Ts>
+constexpr std::array<std::size_t, sizeof...(Ts)> order(void) noexcept
+{
+    constexpr std::size_t N = sizeof...(Ts);
+    constexpr std::string_view names[] = { type_name_v<Ts>.view()... };
+    std::array<std::size_t, N> result {};
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        // The rank of the `i`-th type.
+        std::size_t rank = 0;
+        for (std::size_t j = 0; j < N; ++j)
+        {
+            int c = names[j].compare(names[i]);
+            if (c < 0 || (c == 0 && j < i))
+            {
+                ++rank;
+            }
+        }
+        result[rank] = i;
+    }
+    return result;
+}
+
+template<class List, class Indices>
+struct sort;
+
+template<class... Ts, std::size_t... Ks>
+struct sort<type_list<Ts...>, std::index_sequence<Ks...>>
+{
+    static constexpr auto order_ = order<Ts...>();
+    using type = type_list<
+        std::tuple_element_t<order_[Ks], std::tuple<Ts...>>...>;
+};
+
+template<>
+struct sort<type_list<>, std::index_sequence<>>
+{
+    using type = type_list<>;
+};
+
+} // namespace type_order
+} // namespace details
+
+
+/**
+ * @brief Sort a list of types by their names.
+ *
+ * @tparam List A `type_list<>`.
+ */
+template<class List>
+struct type_sort;
+
+template<class... Ts>
+struct type_sort<type_list<Ts...>>
+{
+    using type = typename details::type_order::sort<
+        type_list<Ts...>, std::index_sequence_for<Ts...>>::type;
+};
+
+template<class List>
+using type_sort_t = typename type_sort<List>::type;
+
+/**
+ * @brief Instantiate a template with the types in a list.
+ *
+ * e.g., `type_list_apply_t<std::tuple, type_list<int, char>>` is
+ * `std::tuple<int, char>`.
+ */
+template<template<class...> class Tmpl, class List>
+struct type_list_apply;
+
+template<template<class...> class Tmpl, class... Ts>
+struct type_list_apply<Tmpl, type_list<Ts...>>
+{
+    using type = Tmpl<Ts...>;
+};
+
+template<template<class...> class Tmpl, class List>
+using type_list_apply_t = typename type_list_apply<Tmpl, List>::type;
+
+/**
+ * @brief A tuple whose element types are sorted by their names.
+ *
+ * The layout of the tuple does not depend upon the order of the types.
+ */
+template<class... Ts>
+using sorted_tuple_t = type_list_apply_t<std::tuple,
+                                         type_sort_t<type_list<Ts...>>>;
+
+/**
+ * @brief The position of a type within a list of types.
+ *
+ * @pre `T` is in `List`.
+ */
+template<class T, class List>
+struct type_position;
+
+template<class T, class... Ts>
+struct type_position<T, type_list<Ts...>>
+{
+private:
+    static constexpr std::size_t find(void) noexcept
+    {
+        constexpr bool same[] = { std::is_same_v<T, Ts>..., false };
+        std::size_t i = 0;
+        while (i < sizeof...(Ts) && !same[i])
+        {
+            ++i;
+        }
+        return i;
+    }
+
+public:
+    static constexpr std::size_t value = find();
+    static_assert(value < sizeof...(Ts), "The type is not in the list.");
+};
+
+template<class T, class List>
+inline constexpr std::size_t type_position_v = type_position<T, List>::value;
+
+} // namespace nsfx
+
+
+#endif // TYPE_ORDER_HPP__4B0C3E2A_7D1F_4C55_9B8E_2F6A1D3C5E70
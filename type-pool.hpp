@@ -0,0 +1,551 @@
+/**
+ * @file
+ *
+ * @brief Per-type object pools with thread-local free lists.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#ifndef TYPE_POOL_HPP__C2D84F1A_6B37_4E95_8A0C_19E5B7D3F264
+#define TYPE_POOL_HPP__C2D84F1A_6B37_4E95_8A0C_19E5B7D3F264
+
+#include "type-name.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace nsfx {
+
+/**
+ * @brief The traits of a type pool.
+ *
+ * Specialize it to change the slab size or the batch size of a type.
+ *
+ * @tparam T The pooled type.
+ */
+template<class T>
+struct type_pool_traits
+{
+    /**
+     * @brief The number of bytes of a slab.
+     *
+     * A slab holds at least one object.
+     */
+    static constexpr std::size_t slab_size = 64 * 1024;
+    /**
+     * @brief The number of objects moved between a thread-local free list
+     *        and the shared free list at a time.
+     */
+    static constexpr std::size_t batch = 64;
+};
+
+/**
+ * @brief The usage of a type pool.
+ */
+struct type_pool_stats
+{
+    std::string_view name_;
+    std::string_view base_;
+    std::uint64_t    hash_;
+    /**
+     * @brief The size class, i.e., the bytes of an object in a slab.
+     */
+    std::size_t      object_size_;
+    std::size_t      slabs_;
+    /**
+     * @brief The number of objects that the slabs can hold.
+     */
+    std::uint64_t    capacity_;
+    /**
+     * @brief The number of objects that are allocated.
+     */
+    std::uint64_t    live_;
+    /**
+     * @brief The number of allocations since the start.
+     */
+    std::uint64_t    allocations_;
+};
+
+namespace details {
+namespace type_pool {
+
+using stats_function = type_pool_stats (*)(void);
+
+/**
+ * @brief The registry of the pools.
+ */
+class registry
+{
+public:
+    static std::size_t add(stats_function f)
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        s.functions_.push_back(f);
+        return s.functions_.size() - 1;
+    }
+
+    static void load(std::vector<stats_function>& out)
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        out.assign(s.functions_.begin(), s.functions_.end());
+    }
+
+private:
+    struct state_t
+    {
+        std::mutex mutex_;
+        std::deque<stats_function> functions_;
+    };
+
+    static state_t& state(void)
+    {
+        // It is never destroyed, so the pools can be reported at exit.
+        static state_t& s = *new state_t;
+        return s;
+    }
+};
+
+/**
+ * @brief A free object, which links to the next free object.
+ */
+struct node
+{
+    node* next_;
+};
+
+/**
+ * @brief The size class of a type.
+ */
+template<class T>
+inline constexpr std::size_t object_alignment =
+    alignof (T) > alignof (node) ? alignof (T) : alignof (node);
+
+template<class T>
+inline constexpr std::size_t object_size =
+    ((sizeof (T) > sizeof (node) ? sizeof (T) : sizeof (node))
+     + object_alignment<T> - 1) / object_alignment<T> * object_alignment<T>;
+
+/**
+ * @brief The pool of a type.
+ *
+ * Each thread owns a free list.
+ * An allocation pops the free list of the calling thread, and a deallocation
+ * pushes it.
+ * The free list is refilled from the shared free list, which is refilled by
+ * carving a new slab, and at most `2 * batch` objects are kept by a thread.
+ * A counter of a free list is only written by its owner thread, thus it is
+ * a relaxed load and a relaxed store (see `type_counter<>`).
+ * When a thread exits, its free list is moved to the shared free list.
+ * A thread gets its free list by its first allocation, so a thread that only
+ * deallocates returns each object to the shared free list.
+ *
+ * The slabs are never released.
+ */
+template<class T>
+class pool
+{
+public:
+    using traits_type = type_pool_traits<T>;
+
+    static constexpr std::size_t size = object_size<T>;
+    static constexpr std::size_t alignment = object_alignment<T>;
+    static constexpr std::size_t batch =
+        traits_type::batch ? traits_type::batch : 1;
+    static constexpr std::size_t per_slab =
+        traits_type::slab_size / size ? traits_type::slab_size / size : 1;
+
+    static void* allocate(void)
+    {
+        cache* c = local_;
+        if (c && c->head_)
+        {
+            node* n = c->head_;
+            c->head_ = n->next_;
+            bump(c->size_, -1);
+            bump(c->allocations_, 1);
+            return n;
+        }
+        return allocate_slow();
+    }
+
+    static void deallocate(void* p) noexcept
+    {
+        cache* c = local_;
+        if (c && relaxed(c->size_) < 2 * batch)
+        {
+            node* n = static_cast<node*>(p);
+            n->next_ = c->head_;
+            c->head_ = n;
+            bump(c->size_, 1);
+            return;
+        }
+        deallocate_slow(p);
+    }
+
+    /**
+     * @brief Get the usage of the pool.
+     *
+     * It is exact if no thread allocates or deallocates concurrently.
+     */
+    static type_pool_stats stats(void)
+    {
+        auto& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        std::uint64_t cached = 0;
+        std::uint64_t allocations = s.retired_;
+        for (cache* c = s.caches_; c; c = c->next_)
+        {
+            cached += relaxed(c->size_);
+            allocations += relaxed(c->allocations_);
+        }
+        const std::uint64_t capacity = s.slabs_.size() * per_slab;
+        return type_pool_stats{
+            nsfx::type_name_v<T>.view(), nsfx::type_base_v<T>.view(),
+            nsfx::type_name<T>::hash(), size, s.slabs_.size(), capacity,
+            capacity - s.free_size_ - cached, allocations};
+    }
+
+    /**
+     * @brief The ID of the pool in the registry.
+     */
+    static inline const std::size_t id = registry::add(&stats);
+
+private:
+    struct cache
+    {
+        node* head_ = nullptr;
+        std::atomic<std::size_t> size_ {0};
+        std::atomic<std::uint64_t> allocations_ {0};
+        cache* prev_ = nullptr;
+        cache* next_ = nullptr;
+    };
+
+    struct state_t
+    {
+        std::mutex mutex_;
+        node* free_ = nullptr;
+        std::size_t free_size_ = 0;
+        std::vector<void*> slabs_;
+        cache* caches_ = nullptr;
+        // The allocations of the exited threads.
+        std::uint64_t retired_ = 0;
+    };
+
+    static state_t& state(void)
+    {
+        // Register the pool.
+        (void)id;
+        // It is never destroyed, so the pool can be reported at exit.
+        static state_t& s = *new state_t;
+        return s;
+    }
+
+    template<class U>
+    static U relaxed(const std::atomic<U>& a) noexcept
+    {
+        return a.load(std::memory_order_relaxed);
+    }
+
+    template<class U>
+    static void bump(std::atomic<U>& a, int n) noexcept
+    {
+        a.store(a.load(std::memory_order_relaxed) + static_cast<U>(n),
+                std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Move the cache to the shared free list when the thread exits.
+     */
+    struct owner
+    {
+        cache* cache_ = nullptr;
+
+        ~owner(void)
+        {
+            if (cache_)
+            {
+                auto& s = state();
+                std::lock_guard<std::mutex> lock(s.mutex_);
+                while (node* n = cache_->head_)
+                {
+                    cache_->head_ = n->next_;
+                    n->next_ = s.free_;
+                    s.free_ = n;
+                    ++s.free_size_;
+                }
+                s.retired_ += relaxed(cache_->allocations_);
+                (cache_->prev_ ? cache_->prev_->next_ : s.caches_) =
+                    cache_->next_;
+                if (cache_->next_)
+                {
+                    cache_->next_->prev_ = cache_->prev_;
+                }
+                delete cache_;
+                local_ = nullptr;
+                exited_ = true;
+            }
+        }
+    };
+
+    /**
+     * @brief Attach a cache to the thread.
+     *
+     * @return `nullptr` if the cache cannot be allocated.
+     */
+    static cache* attach(void) noexcept
+    {
+        thread_local owner o;
+        cache* c = new (std::nothrow) cache;
+        if (!c)
+        {
+            return nullptr;
+        }
+        auto& s = state();
+        {
+            std::lock_guard<std::mutex> lock(s.mutex_);
+            c->next_ = s.caches_;
+            if (s.caches_)
+            {
+                s.caches_->prev_ = c;
+            }
+            s.caches_ = c;
+        }
+        o.cache_ = c;
+        local_ = c;
+        return c;
+    }
+
+    /**
+     * @brief Carve a new slab into the shared free list.
+     *
+     * @pre The mutex is locked.
+     */
+    static void carve(state_t& s)
+    {
+        auto* slab = static_cast<unsigned char*>(::operator new(
+            per_slab * size, std::align_val_t{alignment}));
+        s.slabs_.push_back(slab);
+        for (std::size_t i = per_slab; i-- > 0; )
+        {
+            node* n = reinterpret_cast<node*>(slab + i * size);
+            n->next_ = s.free_;
+            s.free_ = n;
+        }
+        s.free_size_ += per_slab;
+    }
+
+    static void* allocate_slow(void)
+    {
+        auto& s = state();
+        if (exited_)
+        {
+            // The thread is exiting, and its cache has been moved.
+            std::lock_guard<std::mutex> lock(s.mutex_);
+            if (!s.free_)
+            {
+                carve(s);
+            }
+            node* n = s.free_;
+            s.free_ = n->next_;
+            --s.free_size_;
+            ++s.retired_;
+            return n;
+        }
+        cache* c = local_ ? local_ : attach();
+        if (!c)
+        {
+            throw std::bad_alloc();
+        }
+        {
+            // Refill the cache by a batch.
+            std::lock_guard<std::mutex> lock(s.mutex_);
+            if (!s.free_)
+            {
+                carve(s);
+            }
+            std::size_t k = 0;
+            while (s.free_ && k < batch)
+            {
+                node* n = s.free_;
+                s.free_ = n->next_;
+                n->next_ = c->head_;
+                c->head_ = n;
+                ++k;
+            }
+            s.free_size_ -= k;
+            bump(c->size_, static_cast<int>(k));
+        }
+        return allocate();
+    }
+
+    /**
+     * @brief Return an object to the shared free list, along with a batch of
+     *        the cache if the thread has one.
+     *
+     * It never attaches a cache, i.e., it never allocates.
+     */
+    static void deallocate_slow(void* p) noexcept
+    {
+        auto& s = state();
+        node* n = static_cast<node*>(p);
+        cache* c = local_;
+        std::lock_guard<std::mutex> lock(s.mutex_);
+        n->next_ = s.free_;
+        s.free_ = n;
+        ++s.free_size_;
+        if (c)
+        {
+            // Return a batch to the shared free list.
+            std::size_t k = 0;
+            while (c->head_ && k < batch)
+            {
+                node* m = c->head_;
+                c->head_ = m->next_;
+                m->next_ = s.free_;
+                s.free_ = m;
+                ++k;
+            }
+            s.free_size_ += k;
+            bump(c->size_, -static_cast<int>(k));
+        }
+    }
+
+    static inline thread_local cache* local_ = nullptr;
+    static inline thread_local bool exited_ = false;
+};
+
+} // namespace type_pool
+} // namespace details
+
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief The object pool of a type.
+ *
+ * Each type has its own slabs, whose objects are of a single size class
+ * (`sizeof (T)` rounded up to `alignof (T)`), and each thread has its own
+ * free list of the type.
+ * Thus, the common allocation and deallocation are a few loads and stores
+ * without locks.
+ * The usage of the pools is reported by `type_pools::snapshot()`, labelled
+ * by the type names.
+ *
+ * Objects can be deallocated by any thread.
+ * The memory is kept by the pool, and is never returned to the system.
+ *
+ * @code
+ * message* m = nsfx::type_pool<message>::create(args...);
+ * nsfx::type_pool<message>::destroy(m);
+ * @endcode
+ *
+ * @tparam T The pooled type.
+ */
+template<class T>
+struct type_pool
+{
+    using pool_type = details::type_pool::pool<T>;
+
+    /**
+     * @brief Allocate uninitialized storage of an object.
+     */
+    static void* allocate(void)
+    {
+        return pool_type::allocate();
+    }
+
+    /**
+     * @brief Deallocate the storage of an object.
+     *
+     * @pre `p` is allocated by `allocate()`.
+     */
+    static void deallocate(void* p) noexcept
+    {
+        pool_type::deallocate(p);
+    }
+
+    template<class... Args>
+    static T* create(Args&&... args)
+    {
+        void* p = allocate();
+        try
+        {
+            return ::new (p) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocate(p);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Destroy an object that is created by `create()`.
+     */
+    static void destroy(T* p) noexcept
+    {
+        if (p)
+        {
+            p->~T();
+            deallocate(p);
+        }
+    }
+
+    static type_pool_stats stats(void)
+    {
+        return pool_type::stats();
+    }
+};
+
+/**
+ * @brief The usage of all type pools.
+ */
+struct type_pools
+{
+    /**
+     * @brief Take a snapshot of the usage of all pools.
+     *
+     * The pools are ordered by their registration.
+     *
+     * @param[out] out It is cleared before the stats are appended.
+     */
+    static void snapshot(std::vector<type_pool_stats>& out)
+    {
+        // It is not cached in a `thread_local`, since it may be called at
+        // exit, after the thread-local objects have been destroyed.
+        std::vector<details::type_pool::stats_function> functions;
+        details::type_pool::registry::load(functions);
+        out.clear();
+        for (const auto f : functions)
+        {
+            out.push_back(f());
+        }
+    }
+
+    static std::vector<type_pool_stats> snapshot(void)
+    {
+        std::vector<type_pool_stats> out;
+        snapshot(out);
+        return out;
+    }
+};
+
+} // namespace nsfx
+
+
+#endif // TYPE_POOL_HPP__C2D84F1A_6B37_4E95_8A0C_19E5B7D3F264
@@ -0,0 +1,452 @@
+/**
+ * @file
+ *
+ * @brief Binary framing of messages tagged by type hashes.
+ *
+ * @author  Wei Tang <gauchyler@uestc.edu.cn>
+ * @date    2025-03-14
+ *
+ * @copyright Copyright (c) 2025.
+ *   National Key Laboratory of Science and Technology on Communications,
+ *   University of Electronic Science and Technology of China.
+ *   All rights reserved.
+ */
+
+#ifndef TYPED_FRAME_HPP__4A9C0E37_2F1B_4D68_B5E3_81C6D2F07A94
+#define TYPED_FRAME_HPP__4A9C0E37_2F1B_4D68_B5E3_81C6D2F07A94
+
+#include "type-name.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+
+namespace nsfx {
+
+/**
+ * @brief The header of a frame.
+ *
+ * On the wire, it consists of the type hash and the payload length, both
+ * 64-bit little-endian integers, followed by the payload.
+ *
+ * The type hash `0` is reserved for padding frames, whose payloads are
+ * ignored.
+ */
+struct frame_header
+{
+    std::uint64_t type_hash_;
+    std::uint64_t payload_len_;
+
+    /**
+     * @brief The size of the header on the wire.
+     */
+    static constexpr std::size_t size = 16;
+};
+
+/**
+ * @brief The type hash of padding frames.
+ */
+inline constexpr std::uint64_t padding_frame_hash = 0;
+
+namespace details {
+namespace typed_frame {
+
+constexpr void store_le64(unsigned char* dst, std::uint64_t v) noexcept
+{
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        dst[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+}
+
+constexpr std::uint64_t load_le64(const unsigned char* src) noexcept
+{
+    std::uint64_t v = 0;
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        v |= static_cast<std::uint64_t>(src[i]) << (8 * i);
+    }
+    return v;
+}
+
+} // namespace typed_frame
+} // namespace details
+
+
+/**
+ * @brief Write a frame header.
+ *
+ * @param[out] dst At least `frame_header::size` bytes.
+ */
+inline void write_frame_header(void* dst, const frame_header& header) noexcept
+{
+    auto* p = static_cast<unsigned char*>(dst);
+    details::typed_frame::store_le64(p, header.type_hash_);
+    details::typed_frame::store_le64(p + 8, header.payload_len_);
+}
+
+/**
+ * @brief Read a frame header.
+ *
+ * @param[in] src At least `frame_header::size` bytes.
+ */
+inline frame_header read_frame_header(const void* src) noexcept
+{
+    const auto* p = static_cast<const unsigned char*>(src);
+    return frame_header{details::typed_frame::load_le64(p),
+                        details::typed_frame::load_le64(p + 8)};
+}
+
+/**
+ * @brief The frames of a type.
+ *
+ * The type hash is `type_name<T>::versioned_hash()`, a compile-time
+ * constant.
+ * Thus, a frame costs 16 bytes on top of its payload, no matter how long the
+ * type name is.
+ *
+ * @code
+ * unsigned char buf[1024];
+ * std::size_t n = nsfx::typed_frame<ping>::write(buf, p);
+ * @endcode
+ */
+template<class T>
+struct typed_frame
+{
+    static constexpr std::uint64_t type_hash =
+        type_name<T>::versioned_hash();
+
+    static_assert(type_hash != padding_frame_hash,
+                  "The type hash is reserved for padding frames.");
+
+    /**
+     * @brief Get the header of a frame.
+     */
+    static constexpr frame_header header(std::uint64_t payload_len) noexcept
+    {
+        return frame_header{type_hash, payload_len};
+    }
+
+    /**
+     * @brief Write a frame.
+     *
+     * @param[out] dst At least `frame_header::size + len` bytes.
+     *
+     * @return The size of the frame.
+     */
+    static std::size_t write(void* dst, const void* payload,
+                             std::size_t len) noexcept
+    {
+        write_frame_header(dst, header(len));
+        if (len)
+        {
+            std::memcpy(static_cast<unsigned char*>(dst) + frame_header::size,
+                        payload, len);
+        }
+        return frame_header::size + len;
+    }
+
+    /**
+     * @brief Write a frame whose payload is the object representation of a
+     *        value.
+     *
+     * @return The size of the frame.
+     */
+    static std::size_t write(void* dst, const T& value) noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "The payload must be trivially copyable.");
+        return write(dst, &value, sizeof (T));
+    }
+
+    /**
+     * @brief Append a frame to a buffer.
+     */
+    static void append(std::vector<unsigned char>& out, const void* payload,
+                       std::size_t len)
+    {
+        const std::size_t pos = out.size();
+        out.resize(pos + frame_header::size + len);
+        write(out.data() + pos, payload, len);
+    }
+
+    static void append(std::vector<unsigned char>& out, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "The payload must be trivially copyable.");
+        append(out, &value, sizeof (T));
+    }
+};
+
+/**
+ * @brief A frame within a buffer.
+ *
+ * The payload is **not** copied, and it is **not** aligned.
+ */
+struct frame_view
+{
+    std::uint64_t type_hash_;
+    const unsigned char* payload_;
+    std::size_t payload_len_;
+
+    /**
+     * @brief Check whether the frame is of a type.
+     */
+    template<class T>
+    bool is(void) const noexcept
+    {
+        return type_hash_ == typed_frame<T>::type_hash;
+    }
+
+    /**
+     * @brief Copy the payload into a value.
+     *
+     * @return `false` if the frame is not of the type, or the payload length
+     *         is not the size of the type.
+     */
+    template<class T>
+    bool load(T& value) const noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "The payload must be trivially copyable.");
+        if (!is<T>() || payload_len_ != sizeof (T))
+        {
+            return false;
+        }
+        std::memcpy(&value, payload_, sizeof (T));
+        return true;
+    }
+};
+
+/**
+ * @brief Read the frames in a buffer without copying them.
+ *
+ * An incomplete frame at the end of the buffer is left unread, e.g., to be
+ * completed by the next receive.
+ */
+class frame_reader
+{
+public:
+    frame_reader(const void* data, std::size_t size) noexcept
+        : data_(static_cast<const unsigned char*>(data)),
+          size_(size),
+          pos_(0)
+    {
+    }
+
+    /**
+     * @brief Peek the next frame.
+     *
+     * @return `false` if there is no complete frame.
+     */
+    bool peek(frame_view& frame) const noexcept
+    {
+        const std::size_t left = size_ - pos_;
+        if (left < frame_header::size)
+        {
+            return false;
+        }
+        const frame_header h = read_frame_header(data_ + pos_);
+        if (h.payload_len_ > left - frame_header::size)
+        {
+            return false;
+        }
+        frame = frame_view{h.type_hash_, data_ + pos_ + frame_header::size,
+                           static_cast<std::size_t>(h.payload_len_)};
+        return true;
+    }
+
+    /**
+     * @brief Read the next frame.
+     *
+     * @return `false` if there is no complete frame.
+     */
+    bool next(frame_view& frame) noexcept
+    {
+        if (!peek(frame))
+        {
+            return false;
+        }
+        pos_ += frame_header::size + frame.payload_len_;
+        return true;
+    }
+
+    /**
+     * @brief Get the number of bytes of the frames that have been read.
+     */
+    std::size_t consumed(void) const noexcept
+    {
+        return pos_;
+    }
+
+private:
+    const unsigned char* data_;
+    std::size_t size_;
+    std::size_t pos_;
+};
+
+/**
+ * @brief Dispatch frames to handlers by their type hashes.
+ *
+ * The handlers are kept in an open addressing hash table keyed by the type
+ * hashes, which are well mixed already.
+ *
+ * @code
+ * nsfx::frame_dispatcher d;
+ * d.on<ping>([] (void* ctx, const nsfx::frame_view& f) { ... }, ctx);
+ * nsfx::frame_reader r(buf, len);
+ * d.dispatch_all(r);
+ * @endcode
+ */
+class frame_dispatcher
+{
+public:
+    using handler_type = void (*)(void* context, const frame_view& frame);
+
+    frame_dispatcher(void)
+        : slots_(16),
+          count_(0)
+    {
+    }
+
+    /**
+     * @brief Set the handler of a type.
+     *
+     * The previous handler of the type is replaced.
+     */
+    template<class T>
+    void on(handler_type handler, void* context = nullptr)
+    {
+        on(typed_frame<T>::type_hash, handler, context);
+    }
+
+    /**
+     * @brief Set the handler of a type hash.
+     *
+     * The previous handler of the type hash is replaced.
+     *
+     * @return `false` if `type_hash` is `padding_frame_hash`, which is
+     *         reserved and cannot have a handler.
+     */
+    bool on(std::uint64_t type_hash, handler_type handler, void* context)
+    {
+        if (type_hash == padding_frame_hash)
+        {
+            return false;
+        }
+        slot* s = &probe(type_hash);
+        if (s->type_hash_)
+        {
+            s->handler_ = handler;
+            s->context_ = context;
+            return true;
+        }
+        if (2 * (count_ + 1) > slots_.size())
+        {
+            grow();
+            s = &probe(type_hash);
+        }
+        *s = slot{type_hash, handler, context};
+        ++count_;
+        return true;
+    }
+
+    /**
+     * @brief Dispatch a frame to its handler.
+     *
+     * Padding frames are skipped.
+     *
+     * @return `false` if there is no handler of the type.
+     */
+    bool dispatch(const frame_view& frame) const
+    {
+        if (frame.type_hash_ == padding_frame_hash)
+        {
+            return true;
+        }
+        const slot& s = probe(frame.type_hash_);
+        if (!s.type_hash_)
+        {
+            return false;
+        }
+        s.handler_(s.context_, frame);
+        return true;
+    }
+
+    /**
+     * @brief Dispatch all complete frames of a reader.
+     *
+     * @return The number of frames without handlers.
+     */
+    std::size_t dispatch_all(frame_reader& reader) const
+    {
+        std::size_t unknown = 0;
+        frame_view frame;
+        while (reader.next(frame))
+        {
+            unknown += !dispatch(frame);
+        }
+        return unknown;
+    }
+
+    /**
+     * @brief Get the number of types with handlers.
+     */
+    std::size_t size(void) const noexcept
+    {
+        return count_;
+    }
+
+private:
+    struct slot
+    {
+        std::uint64_t type_hash_;
+        handler_type handler_;
+        void* context_;
+    };
+
+    /**
+     * @brief Find the slot of a type hash, or the empty slot to insert it.
+     */
+    const slot& probe(std::uint64_t type_hash) const noexcept
+    {
+        const std::size_t mask = slots_.size() - 1;
+        std::size_t i = static_cast<std::size_t>(type_hash) & mask;
+        while (slots_[i].type_hash_ && slots_[i].type_hash_ != type_hash)
+        {
+            i = (i + 1) & mask;
+        }
+        return slots_[i];
+    }
+
+    slot& probe(std::uint64_t type_hash) noexcept
+    {
+        return const_cast<slot&>(
+            static_cast<const frame_dispatcher*>(this)->probe(type_hash));
+    }
+
+    void grow(void)
+    {
+        std::vector<slot> old(2 * slots_.size());
+        old.swap(slots_);
+        for (const slot& s : old)
+        {
+            if (s.type_hash_)
+            {
+                probe(s.type_hash_) = s;
+            }
+        }
+    }
+
+    // The size is a power of 2, and at most half of the slots are used.
+    std::vector<slot> slots_;
+    std::size_t count_;
+};
+
+} // namespace nsfx
+
+
+#endif // TYPED_FRAME_HPP__4A9C0E37_2F1B_4D68_B5E3_81C6D2F07A94